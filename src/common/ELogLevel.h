@@ -0,0 +1,52 @@
+/**
+ * @file ELogLevel.h
+ * @brief Header file for the ELogLevel enumeration
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @enum ELogLevel
+ * @brief Severity of a diagnostic log record, ordered from the most verbose.
+ */
+enum class ELogLevel {
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR,
+    NONE
+};
+
+/**
+ * @brief Convert ELogLevel to string.
+ * @param level The ELogLevel to convert.
+ * @return String of the ELogLevel.
+ */
+inline std::string eLogLevelToString(ELogLevel level) {
+    switch (level) {
+        case ELogLevel::DEBUG: return "DEBUG";
+        case ELogLevel::INFO: return "INFO";
+        case ELogLevel::WARNING: return "WARNING";
+        case ELogLevel::ERROR: return "ERROR";
+        case ELogLevel::NONE: return "NONE";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Convert string to ELogLevel.
+ * @param str The string to convert.
+ * @return The corresponding ELogLevel, INFO if the string is not recognized.
+ */
+inline ELogLevel logLevelFromString(const std::string& str) {
+    if (str == "DEBUG") return ELogLevel::DEBUG;
+    if (str == "INFO") return ELogLevel::INFO;
+    if (str == "WARNING") return ELogLevel::WARNING;
+    if (str == "ERROR") return ELogLevel::ERROR;
+    if (str == "NONE") return ELogLevel::NONE;
+    return ELogLevel::INFO;
+}
@@ -23,6 +23,7 @@
     REJECT,
     EMPTY,
     REQUEST,
+    SUBSCRIBE,
  };
  
  /**
@@ -40,6 +41,7 @@
         case EMessageType::REJECT: return "REJECT";
         case EMessageType::EMPTY: return "EMPTY";
         case EMessageType::REQUEST: return "REQUEST";
+        case EMessageType::SUBSCRIBE: return "SUBSCRIBE";
         default: return "UNKNOWN";
      }
  }
@@ -58,5 +60,6 @@
     if (str == "REJECT") return EMessageType::REJECT;
     if (str == "EMPTY") return EMessageType::EMPTY;
     if (str == "REQUEST") return EMessageType::REQUEST;
+    if (str == "SUBSCRIBE") return EMessageType::SUBSCRIBE;
     return EMessageType::EMPTY;
  }
\ No newline at end of file
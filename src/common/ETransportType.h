@@ -0,0 +1,55 @@
+/**
+ * @file ETransportType.h
+ * @brief Header file for the ETransportType enumeration
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <string>
+
+/**
+ * @enum ETransportType
+ * @brief Transport used between the GUI and the interpreter.
+ */
+enum class ETransportType {
+    TCP,
+    UNIX,
+    LOOPBACK
+};
+
+/**
+ * @brief Convert ETransportType to string.
+ * @param type The ETransportType to convert.
+ * @return String of the ETransportType.
+ */
+inline std::string eTransportTypeToString(ETransportType type) {
+    switch (type) {
+        case ETransportType::TCP: return "TCP";
+        case ETransportType::UNIX: return "UNIX";
+        case ETransportType::LOOPBACK: return "LOOPBACK";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Convert string to ETransportType.
+ * @param str The string to convert.
+ * @return The corresponding ETransportType, TCP if the string is not recognized.
+ */
+inline ETransportType transportTypeFromString(const std::string& str) {
+    if (str == "UNIX") return ETransportType::UNIX;
+    if (str == "LOOPBACK") return ETransportType::LOOPBACK;
+    return ETransportType::TCP;
+}
+
+/**
+ * @brief Reads the configured transport from the FSMCRAFT_TRANSPORT environment variable.
+ * @return The configured ETransportType, TCP when not set.
+ */
+inline ETransportType transportTypeFromEnvironment() {
+    const char* configured = std::getenv("FSMCRAFT_TRANSPORT");
+    return configured ? transportTypeFromString(configured) : ETransportType::TCP;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file SessionClock.h
+ * @brief Header file for the monotonic event timestamps and their wall-clock anchor.
+ *
+ * Events are stamped with the raw monotonic nanosecond counter, which is cheap to read and
+ * orders events however close together they are. A session captures once how far the wall
+ * clock is ahead of the counter, so consumers can turn a stamp into a date when they display it.
+ *
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+/**
+ * @struct EventTime
+ * @brief Time of an event as carried by LOG messages.
+ */
+struct EventTime {
+    int64_t monotonicNs = 0;    /**< Monotonic counter when the event happened. */
+    int64_t clockOffsetNs = 0;  /**< Wall clock minus monotonic counter, fixed for a session. */
+
+    /**
+     * @brief Gets the wall-clock time of the event.
+     * @return Nanoseconds since the epoch.
+     */
+    int64_t wallNs() const {
+        return monotonicNs + clockOffsetNs;
+    }
+};
+
+/**
+ * @class SessionClock
+ * @brief Stamps the events of one session.
+ */
+class SessionClock {
+public:
+    /**
+     * @brief Anchors the monotonic counter to the current wall-clock time.
+     */
+    SessionClock() {
+        int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        offsetNs = wall - monotonicNs();
+    }
+
+    /**
+     * @brief Reads the monotonic counter.
+     * @return Nanoseconds since an unspecified point, never decreasing.
+     */
+    static int64_t monotonicNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Stamps an event happening now.
+     * @return The event time.
+     */
+    EventTime now() const {
+        return EventTime{monotonicNs(), offsetNs};
+    }
+
+    /**
+     * @brief Formats a wall-clock time in local time, for display by consumers.
+     * @param wallNs Nanoseconds since the epoch.
+     * @return Time as "yyyy-MM-dd hh:mm:ss.uuuuuu".
+     */
+    static std::string format(int64_t wallNs) {
+        int64_t seconds = wallNs / 1000000000;
+        int64_t micros = (wallNs % 1000000000) / 1000;
+        if (micros < 0) {
+            --seconds;
+            micros += 1000000;
+        }
+
+        std::time_t time = static_cast<std::time_t>(seconds);
+        std::tm local{};
+        localtime_r(&time, &local);
+        char buffer[40];
+        size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+        std::snprintf(buffer + length, sizeof(buffer) - length, ".%06lld", static_cast<long long>(micros));
+        return buffer;
+    }
+
+private:
+    int64_t offsetNs;   /**< Wall clock minus monotonic counter at construction. */
+};
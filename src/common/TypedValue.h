@@ -0,0 +1,186 @@
+/**
+ * @file TypedValue.h
+ * @brief Header file for the EValueType enumeration and the TypedValue holding a value in its native type.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <variant>
+
+/**
+ * @enum EValueType
+ * @brief Declared type of an internal variable or an input value.
+ */
+enum class EValueType {
+    INT,
+    FLOAT,
+    BOOL,
+    STRING
+};
+
+/**
+ * @brief Convert EValueType to the type name used in FSM files.
+ * @param type The EValueType to convert.
+ * @return String of the EValueType.
+ */
+inline std::string eValueTypeToString(EValueType type) {
+    switch (type) {
+        case EValueType::INT: return "int";
+        case EValueType::FLOAT: return "float";
+        case EValueType::BOOL: return "bool";
+        case EValueType::STRING: return "string";
+        default: return "string";
+    }
+}
+
+/**
+ * @brief Convert a type name used in FSM files to EValueType.
+ * @param str The string to convert.
+ * @return The corresponding EValueType, STRING for unknown names.
+ */
+inline EValueType valueTypeFromString(const std::string& str) {
+    if (str == "int") return EValueType::INT;
+    if (str == "float" || str == "double") return EValueType::FLOAT;
+    if (str == "bool") return EValueType::BOOL;
+    return EValueType::STRING;
+}
+
+/**
+ * @class TypedValue
+ * @brief A value stored as int64, double, bool or string instead of its text.
+ */
+class TypedValue {
+public:
+    /**
+     * @brief Creates an empty string value.
+     */
+    TypedValue() : value(std::string()) {}
+
+    TypedValue(int64_t value) : value(value) {}
+    TypedValue(double value) : value(value) {}
+    TypedValue(bool value) : value(value) {}
+    TypedValue(std::string value) : value(std::move(value)) {}
+    TypedValue(const char* value) : value(std::string(value)) {}
+
+    /**
+     * @brief Parses the text as the declared type.
+     * @param text The text of the value.
+     * @param type The declared type.
+     * @return The typed value, the text as a string if it is not valid for the type.
+     */
+    static TypedValue parse(const std::string& text, EValueType type) {
+        switch (type) {
+            case EValueType::INT: {
+                int64_t parsed = 0;
+                if (parseInt(text, parsed)) return TypedValue(parsed);
+                // "3.0" is still a whole number
+                double real = 0;
+                if (parseDouble(text, real) && std::trunc(real) == real) return TypedValue(static_cast<int64_t>(real));
+                break;
+            }
+            case EValueType::FLOAT: {
+                double parsed = 0;
+                if (parseDouble(text, parsed)) return TypedValue(parsed);
+                break;
+            }
+            case EValueType::BOOL:
+                if (text == "true") return TypedValue(true);
+                if (text == "false") return TypedValue(false);
+                break;
+            case EValueType::STRING:
+                break;
+        }
+        return TypedValue(text);
+    }
+
+    /**
+     * @brief Detects the type of a value given without a declared type.
+     * @param text The text of the value.
+     * @return The value as int, float or bool if the text is one, otherwise as a string.
+     */
+    static TypedValue infer(const std::string& text) {
+        int64_t integer = 0;
+        if (parseInt(text, integer)) return TypedValue(integer);
+        double real = 0;
+        if (parseDouble(text, real)) return TypedValue(real);
+        if (text == "true") return TypedValue(true);
+        if (text == "false") return TypedValue(false);
+        return TypedValue(text);
+    }
+
+    /**
+     * @brief Gets the type of the stored value.
+     * @return The type.
+     */
+    EValueType type() const {
+        return static_cast<EValueType>(value.index());
+    }
+
+    int64_t toInt() const { return std::get<int64_t>(value); }      ///< Value of an INT.
+    double toDouble() const { return std::get<double>(value); }     ///< Value of a FLOAT.
+    bool toBool() const { return std::get<bool>(value); }           ///< Value of a BOOL.
+    const std::string& str() const { return std::get<std::string>(value); }  ///< Value of a STRING.
+
+    /**
+     * @brief Formats the value the way JS prints it.
+     * @return Text of the value.
+     */
+    std::string toString() const {
+        switch (type()) {
+            case EValueType::INT: return std::to_string(toInt());
+            case EValueType::FLOAT: {
+                double real = toDouble();
+                if (std::isnan(real)) return "NaN";
+                if (std::isinf(real)) return real > 0 ? "Infinity" : "-Infinity";
+                char buffer[32];
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), real);
+                return std::string(buffer, result.ptr);
+            }
+            case EValueType::BOOL: return toBool() ? "true" : "false";
+            default: return str();
+        }
+    }
+
+    bool operator==(const TypedValue& other) const { return value == other.value; }
+    bool operator!=(const TypedValue& other) const { return value != other.value; }
+
+private:
+    /**
+     * @brief Parses the whole text as a decimal integer.
+     * @param text The text.
+     * @param result Receives the number.
+     * @return False if the text is not an integer in range.
+     */
+    static bool parseInt(const std::string& text, int64_t& result) {
+        const char* begin = text.data();
+        const char* end = begin + text.size();
+        if (begin != end && *begin == '+') ++begin;
+        auto parsed = std::from_chars(begin, end, result);
+        return begin != end && parsed.ec == std::errc() && parsed.ptr == end;
+    }
+
+    /**
+     * @brief Parses the whole text as a finite floating point number.
+     * @param text The text.
+     * @param result Receives the number.
+     * @return False if the text is not a finite number.
+     */
+    static bool parseDouble(const std::string& text, double& result) {
+        // strtod also takes leading spaces and hexadecimal numbers, neither is a value here
+        if (text.empty() || std::isspace(static_cast<unsigned char>(text.front())) ||
+            text.find_first_of("xX") != std::string::npos) return false;
+        char* end = nullptr;
+        result = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size() && std::isfinite(result);
+    }
+
+    std::variant<int64_t, double, bool, std::string> value;     /**< Order matches EValueType. */
+};
@@ -0,0 +1,105 @@
+/**
+ * @file ActionPipeline.cpp
+ * @brief Implementation file for the ActionPipeline class
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "ActionPipeline.h"
+#include "../../logger/Logger.h"
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <exception>
+
+ActionPipeline::ActionPipeline(Handler handler, size_t capacity) : shared(std::make_shared<Shared>()) {
+    shared->handler = std::move(handler);
+    shared->capacity = capacity == 0 ? 1 : capacity;
+}
+
+ActionPipeline::~ActionPipeline() {
+    close();
+}
+
+bool ActionPipeline::submit(Message message, int clientSocket) {
+    if (shared->closed.load()) {
+        return false;
+    }
+
+    if (!QCoreApplication::instance()) {
+        shared->handler(message, clientSocket);
+        return true;
+    }
+
+    // Slow path only when the FSM thread is behind by a full queue
+    if (shared->queued.load() >= shared->capacity) {
+        std::unique_lock<std::mutex> lock(shared->spaceMutex);
+        shared->spaceAvailable.wait(lock, [this]() {
+            return shared->closed.load() || shared->queued.load() < shared->capacity;
+        });
+        if (shared->closed.load()) {
+            return false;
+        }
+    }
+
+    Item item;
+    item.message = std::move(message);
+    item.clientSocket = clientSocket;
+    shared->queued.fetch_add(1);
+    shared->queue.push(std::move(item));
+    postDrain(shared);
+    return true;
+}
+
+void ActionPipeline::close() {
+    {
+        // A drain in progress finishes its message first, later drains see the flag
+        std::lock_guard<std::mutex> lock(shared->drainMutex);
+        shared->closed.store(true);
+    }
+    {
+        std::lock_guard<std::mutex> lock(shared->spaceMutex);
+    }
+    shared->spaceAvailable.notify_all();
+}
+
+void ActionPipeline::postDrain(const std::shared_ptr<Shared>& shared) {
+    if (shared->drainPosted.exchange(true)) {
+        return;
+    }
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [shared]() {
+        drain(shared);
+    }, Qt::QueuedConnection);
+}
+
+void ActionPipeline::drain(const std::shared_ptr<Shared>& shared) {
+    std::lock_guard<std::mutex> lock(shared->drainMutex);
+    if (shared->closed.load()) {
+        return;
+    }
+
+    // Cleared before popping, so a message pushed from now on posts a new drain
+    shared->drainPosted.store(false);
+
+    Item item;
+    size_t handled = 0;
+    while (handled < MaxBatch && shared->queue.tryPop(item)) {
+        if (shared->queued.fetch_sub(1) >= shared->capacity) {
+            {
+                std::lock_guard<std::mutex> spaceLock(shared->spaceMutex);
+            }
+            shared->spaceAvailable.notify_all();
+        }
+
+        try {
+            shared->handler(item.message, item.clientSocket);
+        } catch (const std::exception& e) {
+            FSM_LOG_ERROR(std::string("Error processing message: ") + e.what());
+        }
+        ++handled;
+    }
+
+    // Give the event loop a turn before the next batch
+    if (handled == MaxBatch) {
+        postDrain(shared);
+    }
+}
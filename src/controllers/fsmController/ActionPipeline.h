@@ -0,0 +1,109 @@
+/**
+ * @file ActionPipeline.h
+ * @brief Header file for the hand-off of decoded messages from network threads to the FSM thread.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include "../../messages/Message.h"
+#include "../../networkHandler/MpscQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @class ActionPipeline
+ * @brief Bounded queue of decoded messages drained in batches on the thread of the QCoreApplication.
+ *
+ * Network threads frame and decode messages and submit them without taking a lock. The first
+ * submit into an empty pipeline posts one drain to the event loop; the drain handles at most
+ * MaxBatch messages and posts itself again if more are waiting, so the FSM and the GUI keep
+ * getting event loop turns under load. When the queue is full, submitting threads wait, which
+ * pushes back on the connections instead of growing memory.
+ */
+class ActionPipeline {
+public:
+    static constexpr size_t DefaultCapacity = 4096;    ///< Messages queued before submitters wait.
+    static constexpr size_t MaxBatch = 64;             ///< Messages handled per event loop turn.
+
+    /**
+     * @brief Handler of one message, called on the thread of the QCoreApplication.
+     */
+    using Handler = std::function<void(Message& message, int clientSocket)>;
+
+    /**
+     * @brief Creates the pipeline.
+     * @param handler Handler of the drained messages.
+     * @param capacity Number of queued messages before submit() waits.
+     */
+    explicit ActionPipeline(Handler handler, size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Closes the pipeline, messages not handled yet are dropped.
+     */
+    ~ActionPipeline();
+
+    ActionPipeline(const ActionPipeline&) = delete;
+    ActionPipeline& operator=(const ActionPipeline&) = delete;
+
+    /**
+     * @brief Queues a decoded message, may be called from any thread.
+     *
+     * Without a QCoreApplication the message is handled right away on the calling thread.
+     *
+     * @param message The decoded message.
+     * @param clientSocket Client the message came from.
+     * @return False if the pipeline was closed and the message was dropped.
+     */
+    bool submit(Message message, int clientSocket);
+
+    /**
+     * @brief Stops handling messages, waits for a drain in progress and wakes waiting submitters.
+     */
+    void close();
+
+private:
+    /**
+     * @struct Item
+     * @brief A queued message with its origin.
+     */
+    struct Item {
+        Message message;            /**< The decoded message. */
+        int clientSocket = -1;      /**< Client the message came from. */
+    };
+
+    /**
+     * @struct Shared
+     * @brief State shared with the posted drains, which may outlive the pipeline.
+     */
+    struct Shared {
+        Handler handler;                        /**< Handler of the drained messages. */
+        size_t capacity;                        /**< Bound of the queue. */
+        MpscQueue<Item> queue;                  /**< Messages waiting for a drain. */
+        std::atomic<size_t> queued{0};          /**< Number of messages in the queue. */
+        std::atomic<bool> drainPosted{false};   /**< Whether a drain is waiting in the event loop. */
+        std::atomic<bool> closed{false};        /**< Whether messages are still handled. */
+        std::mutex drainMutex;                  /**< Held while a drain runs the handler. */
+        std::mutex spaceMutex;                  /**< Used only by submitters waiting for space. */
+        std::condition_variable spaceAvailable; /**< Signals free space or closing. */
+    };
+
+    /**
+     * @brief Posts a drain to the event loop unless one is already waiting.
+     * @param shared The shared state.
+     */
+    static void postDrain(const std::shared_ptr<Shared>& shared);
+
+    /**
+     * @brief Handles up to MaxBatch queued messages, runs on the thread of the QCoreApplication.
+     * @param shared The shared state.
+     */
+    static void drain(const std::shared_ptr<Shared>& shared);
+
+    std::shared_ptr<Shared> shared;     /**< State shared with the posted drains. */
+};
@@ -7,17 +7,41 @@
  */
 
 #include "FsmController.h"
-#include "../../qtfsm/QTConditionEvent.h"
-#include <QEventLoop>
-#include <QCoreApplication>
+#include "../../common/SessionClock.h"
+#include <QMetaObject>
+#include <cctype>
 
-FsmController::FsmController() {}
+FsmController::FsmController(QTfsm::MessageSink messageSink) : messageSink(std::move(messageSink)) {}
+
+FsmController::~FsmController() {
+    // Sessions still running are stopped like any other, saving their statistics
+    while (!this->sessions.empty()) {
+        endSession(this->sessions.begin(), "released");
+    }
+}
 
 const Message FsmController::performAction(Message &msg) {
     EMessageType type = msg.getType();
     Message response;
+    std::string sessionId = msg.getSessionId();
+    response.setSessionId(sessionId);
+
+    auto session = this->sessions.find(sessionId);
+    if (session != this->sessions.end()) {
+        ++session->second.stats.messages;
+    }
+
     switch (type) {
     case EMessageType::JSON: {
+        if (!isValidSessionId(sessionId)) {
+            response.buildRejectMessage("Invalid session id.");
+            return response;
+        }
+        if (session == this->sessions.end() && this->sessions.size() >= MaxSessions) {
+            response.buildRejectMessage("Too many sessions.");
+            return response;
+        }
+
         std::string name = msg.getJsonName();
         QString fileName = QString::fromStdString(name);
         QFile file(fileName);
@@ -40,69 +64,77 @@ const Message FsmController::performAction(Message &msg) {
             return response;
         }
 
+        // Already on the main thread, the ActionPipeline hands every message over to it
         std::unique_ptr<QTfsmBuilder> builder = std::make_unique<QTfsmBuilder>();
-        QEventLoop loop;
-        bool builtOk = false;
-        QMetaObject::invokeMethod(QCoreApplication::instance(), [&]() {
-            builtOk = builder->buildQTfsm(jsonDoc);
-            loop.quit();
-        }, Qt::QueuedConnection);
-
-        // Wait for FSM build to complete on the main thread
-        loop.exec();
+        bool builtOk = builder->buildQTfsm(jsonDoc);
 
-        this->qtfsm = builder->getBuiltFsm();
+        QTfsm* built = builder->getBuiltFsm();
 
-        if (!this->qtfsm || !builtOk) {
+        if (!built || !builtOk) {
+            if (built) {
+                built->deleteLater();
+            }
             response.buildRejectMessage("Failed to build FSM.");
             return response;
         }
+
+        // Only the FSM of the same session is replaced
+        if (session != this->sessions.end()) {
+            endSession(session, "replaced");
+        }
+
+        Session& started = this->sessions[sessionId];
+        started.fsm = built;
+        started.stats.startedNs = SessionClock::monotonicNs();
+        started.stats.messages = 1;
+
         response.buildAcceptMessage();
-        this->qtfsm->start();
+        built->setSessionId(sessionId);
+        built->setMessageSink(this->messageSink);
+        built->setGuardStatsPath(QTGuardStats::pathFor(fileName));
+        built->start();
+        FSM_LOG_INFO("Session '" + sessionId + "' started, " + std::to_string(this->sessions.size()) + " running.");
         return response;
     }
 
     case EMessageType::INPUT: {
-        if (!this->qtfsm) {
+        if (session == this->sessions.end()) {
             response.buildRejectMessage("FSM not initialized.");
             return response;
         }
 
         std::string name = msg.getInputName();
-        std::string value = msg.getInputValue();
         QString qName = QString::fromStdString(name);
-        QString qValue = QString::fromStdString(value);
-        qtfsm->map[qName] = qValue;
-
-        this->qtfsm->postEvent(new JsConditionEvent(qtfsm->map, qName));
+        session->second.fsm->applyInput(qName, msg.getTypedInputValue());
+        ++session->second.stats.inputs;
         return response;
     }
 
     case EMessageType::STOP: {
-        if (!this->qtfsm) {
-            response.buildRejectMessage("FSM not initialized.");
-            return response;
+        // Stopping is idempotent, the FSM itself reports the STOP it was stopped by
+        if (session != this->sessions.end()) {
+            endSession(session, "stopped");
         }
         response.buildStopMessage();
         return response;
     }
 
     case EMessageType::REQUEST: {
-        if (!this->qtfsm) {
+        if (session == this->sessions.end()) {
             response.buildRejectMessage("FSM not initialized.");
             return response;
         }
 
-        response.buildJsonMessage(this->qtfsm->getName());
+        response.buildJsonMessage(session->second.fsm->getName());
         return response;
 
     }
 
     case EMessageType::REJECT: {
-        if (!this->qtfsm) {
+        if (session == this->sessions.end()) {
             return response;
         }
-        this->qtfsm->stop();
+        endSession(session, "rejected by a client");
         return response;
     }
 
@@ -117,6 +149,53 @@ const Message FsmController::performAction(Message &msg) {
     }
 }
 
-QTfsm* FsmController::getFsm() {
-    return this->qtfsm;
-}
\ No newline at end of file
+void FsmController::endSession(std::map<std::string, Session>::iterator it, const std::string& reason) {
+    std::string sessionId = it->first;
+    QTfsm* fsm = it->second.fsm;
+    SessionStats stats = it->second.stats;
+    stats.logs = fsm->getPublishedLogCount();
+    int64_t runtimeMs = (SessionClock::monotonicNs() - stats.startedNs) / 1000000;
+
+    // Directly on the thread of the QCoreApplication, queued to it from the listener thread
+    QMetaObject::invokeMethod(fsm, [fsm]() {
+        fsm->stop();
+        // Queued events of the machine may still refer to it
+        fsm->deleteLater();
+    }, Qt::AutoConnection);
+    this->sessions.erase(it);
+
+    FSM_LOG_INFO("Session '" + sessionId + "' " + reason + " after " + std::to_string(runtimeMs) + " ms: " +
+                 std::to_string(stats.messages) + " messages, " + std::to_string(stats.inputs) + " inputs, " +
+                 std::to_string(stats.logs) + " LOG messages.");
+}
+
+bool FsmController::isValidSessionId(const std::string& sessionId) {
+    if (sessionId.size() > MaxSessionIdLength) {
+        return false;
+    }
+    for (char c : sessionId) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+QTfsm* FsmController::getFsm(const std::string& sessionId) {
+    auto it = this->sessions.find(sessionId);
+    return it == this->sessions.end() ? nullptr : it->second.fsm;
+}
+
+size_t FsmController::sessionCount() const {
+    return this->sessions.size();
+}
+
+bool FsmController::getSessionStats(const std::string& sessionId, SessionStats& stats) const {
+    auto it = this->sessions.find(sessionId);
+    if (it == this->sessions.end()) {
+        return false;
+    }
+    stats = it->second.stats;
+    stats.logs = it->second.fsm->getPublishedLogCount();
+    return true;
+}
@@ -12,33 +12,105 @@
 #include "../../messages/Message.h"
 #include "../../qtfsm/QTfsmBuilder.h"
 #include <QFile>
+#include <map>
+
+/**
+ * @struct SessionStats
+ * @brief Resources used by one session.
+ */
+struct SessionStats {
+    int64_t startedNs = 0;      /**< Monotonic time the session was started. */
+    uint64_t messages = 0;      /**< Messages handled for the session. */
+    uint64_t inputs = 0;        /**< Inputs applied to its FSM. */
+    uint64_t logs = 0;          /**< LOG messages its FSM published. */
+};
 
 /**
  * @class FsmController
- * @brief Controls the inner FSM based on the received message from
+ * @brief Controls the inner FSMs based on the received message from
  * client gui
+ *
+ * Every message names the session it belongs to, messages without a session id belong
+ * to the default one. A JSON message starts the FSM of its session, replacing a previous
+ * FSM of the same session only, and STOP ends only its session.
  */
 class FsmController {
     private:
     /**
-     * Fsm to controls
+     * @struct Session
+     * @brief A running FSM with its accounting.
      */
-    QTfsm *qtfsm;
+    struct Session {
+        QTfsm* fsm = nullptr;   /**< The FSM, deleted when the session ends. */
+        SessionStats stats;     /**< Resources used so far. */
+    };
+
+    /**
+     * Running sessions by their id
+     */
+    std::map<std::string, Session> sessions;
+
+    /**
+     * Receiver of the LOG and STOP messages of every session FSM
+     */
+    QTfsm::MessageSink messageSink;
+
+    /**
+     * @brief Stops the FSM of the session and removes the session.
+     * @param it The session to end.
+     * @param reason Why the session ends, for the log.
+     */
+    void endSession(std::map<std::string, Session>::iterator it, const std::string& reason);
+
+    /**
+     * @brief Checks that the id can name a session, its journal directory and shared memory.
+     * @param sessionId The id to check.
+     * @return True for ids of at most MaxSessionIdLength letters, digits, '-' and '_'.
+     */
+    static bool isValidSessionId(const std::string& sessionId);
 
     public:
+    static constexpr size_t MaxSessions = 1024;         ///< Sessions running at the same time.
+    static constexpr size_t MaxSessionIdLength = 64;    ///< Longest accepted session id.
+
     /**
      * @brief Constructor
+     * @param messageSink Receiver of the LOG and STOP messages of the session FSMs, called on
+     * the thread of the QCoreApplication; when empty, each FSM connects to the listener itself
+     */
+    explicit FsmController(QTfsm::MessageSink messageSink = nullptr);
+
+    /**
+     * @brief Stops and releases the FSMs of the sessions still running
      */
-    FsmController();
+    ~FsmController();
+
+    FsmController(const FsmController&) = delete;
+    FsmController& operator=(const FsmController&) = delete;
+
     /**
-     * @brief Performs actions on the FSM based on message
+     * @brief Performs actions on the FSM of the message session based on message,
+     * must be called on the thread of the QCoreApplication
      * @param msg Message to base the action on
-     * @return Message for further sending
+     * @return Message for further sending, in the session of msg
      */
     const Message performAction(Message &msg);
     /**
-     * @brief Gets the fsm it is controlling
-     * @return Fsm controlling
+     * @brief Gets the fsm of a session
+     * @param sessionId Id of the session, the default session if empty
+     * @return Fsm controlling, nullptr if the session is not running
+     */
+    QTfsm* getFsm(const std::string& sessionId = "");
+    /**
+     * @brief Gets the number of running sessions
+     * @return Session count
+     */
+    size_t sessionCount() const;
+    /**
+     * @brief Gets the resources used by a session
+     * @param sessionId Id of the session
+     * @param stats Receives the accounting
+     * @return False if the session is not running
      */
-    QTfsm* getFsm();
-};
\ No newline at end of file
+    bool getSessionStats(const std::string& sessionId, SessionStats& stats) const;
+};
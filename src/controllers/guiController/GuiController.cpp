@@ -11,6 +11,8 @@
 #include <iostream>
 #include "../networkHandler/NetworkHandler.h"
 #include <QMetaObject>
+#include <stdexcept>
+#include "../../logger/Logger.h"
 
 GuiController::GuiController(IMainWindow* gui) {
     this->gui = gui;
@@ -18,8 +20,6 @@ GuiController::GuiController(IMainWindow* gui) {
 }
 
 void GuiController::performAction(Message &msg) {
-    // communication is too fast, we have to limit it
-    std::this_thread::sleep_for(std::chrono::seconds(1)); 
     EMessageType type = msg.getType();
     
     switch (type) {
@@ -31,41 +31,15 @@ void GuiController::performAction(Message &msg) {
         }
 
         case (EMessageType::LOG) : {
-            
-            EItemType activableType = msg.getElementType();
-            std::string activableID = msg.getCurrentElement();
-        
-            QMetaObject::invokeMethod(this, [this, activableID, activableType]() {
-                IActivable& toActivate = this->gui->getActivableItem(activableType, activableID);
-                this->gui->highlightItem(true, toActivate);
-            }, Qt::QueuedConnection);
-           
-
-            std::string log = msg.getLogString();
-            QMetaObject::invokeMethod(this, [log, this]() {
-                this->gui->printLog(log);
-            }, Qt::QueuedConnection);
-
-            auto outputs = msg.getOutputValues();
-
-            for (const auto& output : outputs) {
-                std::string name = output.first;
-                std::string value = output.second;
-            
-                QMetaObject::invokeMethod(this, [this, name, value]() {
-                    this->gui->showOutput(name, value);
+            // LOG messages arriving faster than the GUI repaints are coalesced
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            pendingLogs.push_back(msg);
+            if (!flushPosted) {
+                flushPosted = true;
+                QMetaObject::invokeMethod(this, [this]() {
+                    flushLogs();
                 }, Qt::QueuedConnection);
             }
-            auto inputs = msg.getInputValues();
-
-            for (const auto& input : inputs) {
-                std::string name = input.first;
-                std::string value = input.second;
-                QMetaObject::invokeMethod(this, [this, name, value]() {
-                    this->gui->showInput(name, value);
-                }, Qt::QueuedConnection);
-            }
-
             break;
         }
 
@@ -88,3 +62,31 @@ void GuiController::performAction(Message &msg) {
             break;
     };
 }
+
+void GuiController::flushLogs() {
+    std::vector<Message> logs;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        logs.swap(pendingLogs);
+        flushPosted = false;
+    }
+    if (logs.empty())
+        return;
+
+    for (const Message& log : logs)
+        this->gui->printLog(log);
+
+    const Message& last = logs.back();
+    EItemType activableType = last.getElementType();
+    std::string activableID = last.getCurrentElement();
+    // The scene is filled in slices, the item may not be there yet
+    try {
+        IActivable& toActivate = this->gui->getActivableItem(activableType, activableID);
+        this->gui->highlightItem(true, toActivate);
+    } catch (const std::runtime_error&) {
+        FSM_LOG_DEBUG("Item " + activableID + " is not in the scene yet.");
+    }
+
+    // Every LOG carries all values, the last one is the current state
+    this->gui->showValues(last);
+}
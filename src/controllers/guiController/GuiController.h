@@ -9,6 +9,8 @@
 #include "../../gui/IMainWindow.h"
 #include "../../messages/Message.h"
 #include <QObject>
+#include <mutex>
+#include <vector>
 
 /**
  * @class GuiController
@@ -21,6 +23,18 @@ private:
      * GUI window to control
      */
     IMainWindow* gui;
+
+    std::mutex pendingMutex;            ///< Guards pendingLogs and flushPosted
+    std::vector<Message> pendingLogs;   ///< LOG messages not yet shown, in arrival order
+    bool flushPosted = false;           ///< Whether flushLogs() is queued to the GUI thread
+
+    /**
+     * @brief Shows the pending LOG messages, runs on the GUI thread.
+     *
+     * Every message is logged, only the last one highlights its element and
+     * updates the tables, so a fast run costs one repaint per event loop turn.
+     */
+    void flushLogs();
 public:
     /**
      * @brief Constructor for the controller
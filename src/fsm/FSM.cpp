@@ -15,7 +15,7 @@ FSM::FSM(const std::string& name)
     : name(name), currentState("") {}
 
 void FSM::addState(const std::shared_ptr<State>& state) {
-    states[state->getName()] = state;
+    states.add(state);
     if (state->isInitialState()) {
         currentState = state->getName();
     }
@@ -26,7 +26,7 @@ void FSM::addTransition(const std::shared_ptr<Transition>& transition) {
 }
 
 void FSM::setInitialState(const std::string& stateName) {
-    if (states.count(stateName)) {
+    if (states.contains(stateName)) {
         currentState = stateName;
     }
 }
@@ -47,11 +47,11 @@ std::string FSM::getName() {
     return name;
 }
 
-std::map<std::string, std::shared_ptr<State>> FSM::getStates() {
+const StateTable& FSM::getStates() const {
     return states;
 }
 
-std::vector<std::shared_ptr<Transition>> FSM::getTransitions() {
+const std::vector<std::shared_ptr<Transition>>& FSM::getTransitions() const {
     return transitions;
 }
 
@@ -12,6 +12,7 @@
 #include <vector>
 #include <memory>
 #include "State.h"
+#include "StateTable.h"
 #include "Transition.h"
 #include "InternalVar.h"
 
@@ -33,9 +34,9 @@ private:
     std::string comment;
 
     /**
-     * A map of states based on their name
+     * States in insertion order, indexed by their name
      */
-    std::map<std::string, std::shared_ptr<State>> states;
+    StateTable states;
 
     /**
      * A vector of transitions
@@ -119,15 +120,15 @@ public:
 
     /**
      * @brief Retrieves all states defined in the FSM.
-     * @return A std::map where keys are state names and values are shared pointers to State objects.
+     * @return The table of states, iterated in insertion order and searchable by name.
      */
-    std::map<std::string, std::shared_ptr<State>> getStates();
+    const StateTable& getStates() const;
 
     /**
      * @brief Retrieves all transitions defined in the FSM.
      * @return A std::vector containing shared pointers to Transition objects.
      */
-    std::vector<std::shared_ptr<Transition>> getTransitions();
+    const std::vector<std::shared_ptr<Transition>>& getTransitions() const;
 
     /**
      * @brief Gets the list of input variable names used by the FSM.
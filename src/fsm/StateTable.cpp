@@ -0,0 +1,102 @@
+/**
+ * @file StateTable.cpp
+ * @brief Implements the StateTable container holding the states of an FSM.
+ * @author xnovakf00
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "StateTable.h"
+
+bool StateTable::add(const std::shared_ptr<State>& state) {
+    auto [it, inserted] = indexByName.emplace(state->getName(), states.size());
+    if (inserted) {
+        states.push_back(state);
+    } else {
+        if (states[it->second]->getName() == initialName && !state->isInitialState()) {
+            initialName.clear();
+        }
+        states[it->second] = state;
+    }
+
+    if (state->isInitialState()) {
+        initialName = state->getName();
+    }
+    return inserted;
+}
+
+std::shared_ptr<State> StateTable::find(const std::string& name) const {
+    auto it = indexByName.find(name);
+    return it == indexByName.end() ? nullptr : states[it->second];
+}
+
+bool StateTable::contains(const std::string& name) const {
+    return indexByName.count(name) != 0;
+}
+
+bool StateTable::remove(const std::string& name) {
+    auto it = indexByName.find(name);
+    if (it == indexByName.end()) {
+        return false;
+    }
+
+    size_t index = it->second;
+    indexByName.erase(it);
+    if (index != states.size() - 1) {
+        states[index] = std::move(states.back());
+        indexByName[states[index]->getName()] = index;
+    }
+    states.pop_back();
+
+    if (name == initialName) {
+        initialName.clear();
+    }
+    return true;
+}
+
+bool StateTable::setInitial(const std::string& name, bool initial) {
+    std::shared_ptr<State> state = find(name);
+    if (!state) {
+        return false;
+    }
+
+    if (initial) {
+        if (!initialName.empty() && initialName != name) {
+            std::shared_ptr<State> previous = find(initialName);
+            if (previous) {
+                previous->setInitial(false);
+            }
+        }
+        initialName = name;
+    } else if (initialName == name) {
+        initialName.clear();
+    }
+    state->setInitial(initial);
+    return true;
+}
+
+const std::string& StateTable::getInitial() const {
+    return initialName;
+}
+
+void StateTable::clear() {
+    states.clear();
+    indexByName.clear();
+    initialName.clear();
+}
+
+size_t StateTable::size() const {
+    return states.size();
+}
+
+bool StateTable::empty() const {
+    return states.empty();
+}
+
+StateTable::const_iterator StateTable::begin() const {
+    return states.begin();
+}
+
+StateTable::const_iterator StateTable::end() const {
+    return states.end();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file StateTable.h
+ * @brief Declares the StateTable container holding the states of an FSM.
+ * @author xnovakf00
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "State.h"
+
+/**
+ * @class StateTable
+ * @brief States in insertion order with constant-time lookup by name.
+ *
+ * Used both by the FSM model and by the editor, so neither has a limit on the number of
+ * states. The table also remembers the initial state, changing it does not scan the states.
+ * Initial flags should therefore be changed through setInitial() of the table.
+ */
+class StateTable {
+public:
+    using const_iterator = std::vector<std::shared_ptr<State>>::const_iterator;
+
+    /**
+     * @brief Adds a state, replacing a state of the same name.
+     * @param state The state to add.
+     * @return True if the name was not in the table before.
+     */
+    bool add(const std::shared_ptr<State>& state);
+
+    /**
+     * @brief Finds a state by its name.
+     * @param name Name of the state.
+     * @return The state, or nullptr if there is none.
+     */
+    std::shared_ptr<State> find(const std::string& name) const;
+
+    /**
+     * @brief Checks whether a state of the given name exists.
+     * @param name Name of the state.
+     * @return True if the state exists.
+     */
+    bool contains(const std::string& name) const;
+
+    /**
+     * @brief Removes a state, the last state takes its position.
+     * @param name Name of the state.
+     * @return True if the state existed.
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * @brief Marks a state as initial or not, unmarking the previous initial state.
+     * @param name Name of the state.
+     * @param initial True to make the state initial.
+     * @return False if the state does not exist.
+     */
+    bool setInitial(const std::string& name, bool initial);
+
+    /**
+     * @brief Gets the name of the initial state.
+     * @return The name, empty if no state is initial.
+     */
+    const std::string& getInitial() const;
+
+    /**
+     * @brief Removes all states.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of states.
+     * @return Number of states.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Checks whether the table has no states.
+     * @return True if empty.
+     */
+    bool empty() const;
+
+    /** @brief First state in insertion order. */
+    const_iterator begin() const;
+
+    /** @brief End of the states. */
+    const_iterator end() const;
+
+private:
+    std::vector<std::shared_ptr<State>> states;            ///< States in insertion order
+    std::unordered_map<std::string, size_t> indexByName;   ///< Position of every state in states
+    std::string initialName;                               ///< Name of the initial state
+};
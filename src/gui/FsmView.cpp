@@ -0,0 +1,83 @@
+/**
+ * @file FsmView.cpp
+ * @brief Implementation of the graphics view showing the FSM diagram.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "FsmView.h"
+#include <QWheelEvent>
+#include <QKeyEvent>
+#include <QPainter>
+#include <QRegion>
+#include <QtMath>
+
+FsmView::FsmView(QGraphicsScene* scene, QWidget* parent) : QGraphicsView(scene, parent) {
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    setResizeAnchor(QGraphicsView::AnchorViewCenter);
+
+    // Items keep their pens inside boundingRect(), so no extra margin is needed per update
+    setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing, true);
+    setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    setCacheMode(QGraphicsView::CacheBackground);
+}
+
+void FsmView::setFrameStatsVisible(bool visible) {
+    frameStatsVisible = visible;
+    overlayRect = QRect();
+    viewport()->update();
+}
+
+qreal FsmView::zoom() const {
+    return transform().m11();
+}
+
+void FsmView::wheelEvent(QWheelEvent* event) {
+    qreal factor = qPow(1.0015, event->angleDelta().y());
+    qreal target = qBound(MinZoom, zoom() * factor, MaxZoom);
+    if (qFuzzyCompare(target, zoom())) {
+        event->accept();
+        return;
+    }
+
+    factor = target / zoom();
+    scale(factor, factor);
+    event->accept();
+}
+
+void FsmView::keyPressEvent(QKeyEvent* event) {
+    if (event->key() == Qt::Key_F3) {
+        setFrameStatsVisible(!frameStatsVisible);
+        return;
+    }
+    QGraphicsView::keyPressEvent(event);
+}
+
+void FsmView::paintEvent(QPaintEvent* event) {
+    frameTimer.start();
+    QGraphicsView::paintEvent(event);
+    lastFrameMs = frameTimer.nsecsElapsed() / 1e6;
+    averageFrameMs = averageFrameMs == 0.0 ? lastFrameMs : averageFrameMs * 0.9 + lastFrameMs * 0.1;
+
+    if (!frameStatsVisible)
+        return;
+
+    QString stats = QString("frame %1 ms  avg %2 ms  zoom %3")
+        .arg(lastFrameMs, 0, 'f', 2)
+        .arg(averageFrameMs, 0, 'f', 2)
+        .arg(zoom(), 0, 'f', 2);
+
+    QPainter painter(viewport());
+    QRect box = painter.fontMetrics().boundingRect(stats).adjusted(-4, -2, 4, 2);
+    box.moveTopLeft(QPoint(6, 6));
+    // Only grows, so a shorter text still covers the pixels of a longer one
+    overlayRect = overlayRect.united(box);
+    painter.fillRect(overlayRect, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    painter.drawText(overlayRect, Qt::AlignCenter, stats);
+
+    // Minimal updates and scrolling clip or move the box, a frame that missed part of it repaints it whole
+    if (!QRegion(overlayRect).subtracted(event->region()).isEmpty()) {
+        viewport()->update(overlayRect);
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file FsmView.h
+ * @brief Header file for the graphics view showing the FSM diagram.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QGraphicsView>
+#include <QElapsedTimer>
+#include <QRect>
+
+/**
+ * @brief Graphics view of the FSM editor with wheel zoom and an optional frame-time overlay.
+ *
+ * Items decide their level of detail from the view transform, so zooming out on a large
+ * graph draws plain circles and lines. F3 toggles the overlay with the paint time of the
+ * last frame and its moving average, which is the number to watch when tuning rendering.
+ */
+class FsmView : public QGraphicsView {
+    Q_OBJECT
+
+public:
+    static constexpr qreal MinZoom = 0.05;     ///< Smallest allowed scale
+    static constexpr qreal MaxZoom = 4.0;      ///< Largest allowed scale
+
+    /**
+     * @brief Constructor for the view.
+     * @param scene Scene to show.
+     * @param parent Optional parent widget.
+     */
+    FsmView(QGraphicsScene* scene, QWidget* parent = nullptr);
+
+    /**
+     * @brief Shows or hides the frame-time overlay.
+     * @param visible True to show the overlay.
+     */
+    void setFrameStatsVisible(bool visible);
+
+    /**
+     * @brief Gets the current zoom factor.
+     * @return Horizontal scale of the view transform.
+     */
+    qreal zoom() const;
+
+protected:
+    /**
+     * @brief Zooms around the mouse cursor.
+     * @param event The wheel event.
+     */
+    void wheelEvent(QWheelEvent* event) override;
+
+    /**
+     * @brief Toggles the frame-time overlay on F3.
+     * @param event The key event.
+     */
+    void keyPressEvent(QKeyEvent* event) override;
+
+    /**
+     * @brief Paints the scene and measures how long it took.
+     * @param event The paint event.
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    bool frameStatsVisible = false;   ///< Whether the overlay is drawn
+    QElapsedTimer frameTimer;         ///< Measures one paint
+    double lastFrameMs = 0.0;         ///< Paint time of the last frame
+    double averageFrameMs = 0.0;      ///< Exponential moving average of the paint time
+    QRect overlayRect;                ///< Viewport area of the overlay, empty until it is drawn
+};
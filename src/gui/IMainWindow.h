@@ -11,6 +11,7 @@
 #include "../common/EItemType.h"
 #include <string>
 #include "../networkHandler/NetworkHandler.h"
+#include "../messages/Message.h"
 
 /**
  * @brief IMainWindow interface
@@ -31,23 +32,15 @@ public:
 
     /**
      * @brief Print the log.
+     * @param log The LOG message to add to the log view.
      */
-    virtual void printLog(std::string logMessage) = 0;
+    virtual void printLog(const Message& log) = 0;
 
     /**
-     * @brief Show the output of the FSM.
-     * @param outputID The ID of the output to show.
-     * @param outputValue The value of the output to show.
+     * @brief Show the input and output values carried by a LOG message.
+     * @param log The LOG message whose values to show.
      */
-    virtual void showOutput(std::string outputID, std::string outputValue) = 0;
-
-    /**
-     * @brief Show the input of the FSM.
-     * @param inputID The ID of the input to show.
-     * @param inputValue The value of the input to show.
-     */
-    virtual void showInput(std::string inputID, std::string inputValue) = 0;
-
+    virtual void showValues(const Message& log) = 0;
 
     /**
      * @brief Shows an error message on screen.
@@ -0,0 +1,35 @@
+/**
+ * @file LogFilterModel.cpp
+ * @brief Implementation of the proxy filtering the log view by element and variable.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "LogFilterModel.h"
+#include "LogModel.h"
+
+LogFilterModel::LogFilterModel(QObject* parent) : QSortFilterProxyModel(parent) {}
+
+void LogFilterModel::setElementFilter(const QString& element) {
+    elementFilter = element.trimmed();
+    invalidateFilter();
+}
+
+void LogFilterModel::setVariableFilter(const QString& variable) {
+    variableFilter = variable.trimmed();
+    invalidateFilter();
+}
+
+bool LogFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex&) const {
+    if (elementFilter.isEmpty() && variableFilter.isEmpty())
+        return true;
+
+    auto* logModel = static_cast<const LogModel*>(sourceModel());
+    const LogRecord& record = logModel->recordAt(sourceRow);
+
+    if (!elementFilter.isEmpty() && record.element != elementFilter)
+        return false;
+    if (!variableFilter.isEmpty() && !record.changed.contains(variableFilter))
+        return false;
+    return true;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file LogFilterModel.h
+ * @brief Header file for the proxy filtering the log view by element and variable.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QSortFilterProxyModel>
+#include <QString>
+
+/**
+ * @brief Shows only log records of a chosen element or in which a chosen variable changed.
+ *
+ * Filters read the prepared fields of LogModel records directly, no text matching over
+ * the formatted rows is done. Empty filters accept every record.
+ */
+class LogFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for the filter model.
+     * @param parent Optional parent object.
+     */
+    explicit LogFilterModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Sets the state name or transition id to show.
+     * @param element Element to show, empty for all.
+     */
+    void setElementFilter(const QString& element);
+
+    /**
+     * @brief Sets the variable whose changes are shown.
+     * @param variable Input, output or internal variable name, empty for all.
+     */
+    void setVariableFilter(const QString& variable);
+
+protected:
+    /**
+     * @brief Checks the record against both filters.
+     * @param sourceRow Row in the LogModel.
+     * @param sourceParent Unused, the model is a flat list.
+     * @return True if the record is shown.
+     */
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    QString elementFilter;   ///< Element to show, empty for all
+    QString variableFilter;  ///< Variable whose changes are shown, empty for all
+};
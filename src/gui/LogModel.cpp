@@ -0,0 +1,98 @@
+/**
+ * @file LogModel.cpp
+ * @brief Implementation of the list model holding the most recent LOG records of a run.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "LogModel.h"
+#include <algorithm>
+
+/**
+ * @brief Formats one group of values and notes which of them changed.
+ * @param label Group label shown before the values.
+ * @param values Names and values of the group.
+ * @param lastValues Values of the previous record keyed by label and name, updated in place.
+ * @param changed Receives the names whose value changed.
+ * @return The formatted group.
+ */
+static QString formatValues(const QString& label,
+                            const std::map<std::string, std::string>& values,
+                            QHash<QString, QString>& lastValues,
+                            QStringList& changed) {
+    QStringList parts;
+    for (const auto& [name, value] : values) {
+        QString key = QString::fromStdString(name);
+        QString val = QString::fromStdString(value);
+        // An input and an output may share a name, each group keeps its own previous value
+        QString groupKey = label + key;
+        auto last = lastValues.find(groupKey);
+        if (last == lastValues.end() || last.value() != val) {
+            changed << key;
+            lastValues.insert(groupKey, val);
+        }
+        parts << key + "=" + val;
+    }
+    return label + parts.join(", ");
+}
+
+LogModel::LogModel(int capacity, QObject* parent)
+    : QAbstractListModel(parent), ring(static_cast<size_t>(std::max(1, capacity))) {}
+
+int LogModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : count;
+}
+
+QVariant LogModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= count)
+        return QVariant();
+
+    const LogRecord& record = recordAt(index.row());
+    if (role == Qt::DisplayRole)
+        return record.text;
+    if (role == Qt::ToolTipRole)
+        return record.details;
+    return QVariant();
+}
+
+void LogModel::append(const Message& log) {
+    LogRecord record;
+    record.elementType = log.getElementType();
+    record.element = QString::fromStdString(log.getCurrentElement());
+
+    QString inputs = formatValues("in: ", log.getInputValues(), lastValues, record.changed);
+    QString outputs = formatValues("out: ", log.getOutputValues(), lastValues, record.changed);
+    QString internals = formatValues("var: ", log.getInternalValues(), lastValues, record.changed);
+
+    record.text = "[" + QString::fromStdString(log.getTimestamp()) + "] " +
+        QString::fromStdString(eItemTypeToString(record.elementType)) + " " + record.element +
+        " | " + inputs + " | " + outputs + " | " + internals;
+    record.details = QString::fromStdString(log.getLogString()).trimmed();
+
+    int capacity = static_cast<int>(ring.size());
+    if (count == capacity) {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        head = (head + 1) % capacity;
+        --count;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), count, count);
+    ring[static_cast<size_t>((head + count) % capacity)] = std::move(record);
+    ++count;
+    endInsertRows();
+}
+
+void LogModel::clear() {
+    beginResetModel();
+    for (LogRecord& record : ring)
+        record = LogRecord();
+    head = 0;
+    count = 0;
+    lastValues.clear();
+    endResetModel();
+}
+
+const LogRecord& LogModel::recordAt(int row) const {
+    return ring[static_cast<size_t>((head + row) % static_cast<int>(ring.size()))];
+}
@@ -0,0 +1,87 @@
+/**
+ * @file LogModel.h
+ * @brief Header file for the list model holding the most recent LOG records of a run.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "../common/EItemType.h"
+#include "../messages/Message.h"
+
+/**
+ * @brief One LOG message prepared for display and filtering.
+ */
+struct LogRecord {
+    EItemType elementType = EItemType::STATE; ///< Type of the entered or taken element
+    QString element;                          ///< State name or transition id
+    QStringList changed;                      ///< Variables whose value differs from the previous record
+    QString text;                             ///< Single-line text shown in the view
+    QString details;                          ///< Full multi-line text shown as tooltip
+};
+
+/**
+ * @brief Model over a fixed-capacity ring of log records.
+ *
+ * Memory stays flat for runs of any length: once the ring is full, the oldest record is
+ * dropped for every new one. Rows are single lines so views can use uniform item sizes
+ * and only lay out the rows that are visible.
+ */
+class LogModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static constexpr int DefaultCapacity = 10000; ///< Records kept by default
+
+    /**
+     * @brief Constructor for the log model.
+     * @param capacity Maximum number of records kept.
+     * @param parent Optional parent object.
+     */
+    explicit LogModel(int capacity = DefaultCapacity, QObject* parent = nullptr);
+
+    /**
+     * @brief Number of records currently kept.
+     * @param parent Unused, the model is a flat list.
+     * @return Row count.
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Provides the text and tooltip of a record.
+     * @param index Row of the record.
+     * @param role Qt::DisplayRole or Qt::ToolTipRole.
+     * @return The requested data.
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Appends a LOG message, dropping the oldest record when full.
+     * @param log The LOG message.
+     */
+    void append(const Message& log);
+
+    /**
+     * @brief Removes all records.
+     */
+    void clear();
+
+    /**
+     * @brief Gets a record by its row, row 0 is the oldest.
+     * @param row Row of the record.
+     * @return Reference to the record.
+     */
+    const LogRecord& recordAt(int row) const;
+
+private:
+    std::vector<LogRecord> ring;            ///< Storage, capacity records
+    int head = 0;                           ///< Index of the oldest record
+    int count = 0;                          ///< Number of kept records
+    QHash<QString, QString> lastValues;     ///< Variable values of the previous record, keyed by group label and name
+};
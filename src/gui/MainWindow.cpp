@@ -20,21 +20,26 @@
 #include <QAction>
 #include <QDebug>
 #include <QTextEdit>
+#include <QScrollBar>
+#include <QHeaderView>
 #include "../io/JsonMaker.h"
+#include "../common/TypedValue.h"
 #include <QFile>
 #include <QJsonDocument>
 #include <QRegularExpression>
 #include "TransitionItem.h"
-#include "QFlowLayout.h"
 #include <QFileDialog>
 #include <QDir>
 #include "../io/JsonLoader.h"
 #include "../messages/Message.h"
 #include "../controllers/fsmController/FsmController.h"
 #include "../controllers/guiController/GuiController.h"
-#include <QThread>
 #include <cmath>
 #include <QRandomGenerator>
+#include <QDateTime>
+#include <climits>
+#include <QElapsedTimer>
+#include <QLineF>
 
 constexpr int CircleDiameter = 80; 
 constexpr int CircleRadius = CircleDiameter / 2; 
@@ -43,11 +48,6 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), addingNewState(false), ghostCircle(nullptr), networkHandler("127.0.0.1", 8080),
     networkHandler2("127.0.0.1", 8080) {
 
-    // Initialize state list
-    for (int i = 0; i < MAX_STATES; ++i) {
-        stateList[i] = nullptr;
-    }
-
     QWidget *centralWidget = new QWidget(this);
     centralWidget->setObjectName("centralWidget");
     setCentralWidget(centralWidget);
@@ -107,11 +107,19 @@ MainWindow::MainWindow(QWidget *parent)
     uploadButton->setFixedSize(50, 32);
     toolbarLayout->addWidget(uploadButton);
 
+    // Replay Button
+    QToolButton *replayButton = new QToolButton(toolbarWidget);
+    replayButton->setText("Replay");
+    replayButton->setToolTip("Replay recorded journal");
+    replayButton->setFixedSize(50, 32);
+    toolbarLayout->addWidget(replayButton);
+
     connect(runButton, &QToolButton::clicked, this, &MainWindow::onRunClicked);
     connect(newStateButton, &QToolButton::clicked, this, &MainWindow::onNewStateButtonClicked);
     connect(clearButton, &QToolButton::clicked, this, &MainWindow::onClearClicked);
     connect(saveButton, &QToolButton::clicked, this, &MainWindow::onSaveClicked);
     connect(uploadButton, &QToolButton::clicked, this, &MainWindow::onUploadClicked);
+    connect(replayButton, &QToolButton::clicked, this, &MainWindow::onReplayClicked);
 
     leftLayout->addWidget(toolbarWidget, 0, Qt::AlignLeft);
 
@@ -190,12 +198,10 @@ MainWindow::MainWindow(QWidget *parent)
     leftLayout->addWidget(envInputRow);
     leftLayout->addSpacing(2);
 
-    internalVarsContainer = new QWidget(this);
-    internalVarsFlow = new QFlowLayout(internalVarsContainer);
-    internalVarsFlow->setContentsMargins(5, 5, 5, 5);
-    internalVarsFlow->setSpacing(8);
-    
-    leftLayout->addWidget(internalVarsContainer);
+    // Initial values of internals can be edited in place, only the edited cell gets an editor
+    internalsModel = new VariableTableModel(true, this);
+    internalsView = createVariableView(internalsModel, 110);
+    leftLayout->addWidget(internalsView);
 
     // Input container --
     QLabel* inputLabel2 = new QLabel("Declare inputs:");
@@ -234,18 +240,9 @@ MainWindow::MainWindow(QWidget *parent)
 
     leftLayout->addWidget(inputRow);
 
-    QScrollArea* inputScrollArea = new QScrollArea(this);
-    inputScrollArea->setWidgetResizable(true);
-    inputScrollArea->setFixedHeight(150); // Optional: set max height
-
-    inputListContainer = new QWidget(this);
-    inputListLayout = new QVBoxLayout(inputListContainer);
-    inputListLayout->setContentsMargins(5, 5, 5, 5);
-    inputListLayout->setSpacing(8);
-    inputListLayout->addStretch();
-
-    inputScrollArea->setWidget(inputListContainer);
-    leftLayout->addWidget(inputScrollArea);
+    inputsModel = new VariableTableModel(false, this);
+    inputsView = createVariableView(inputsModel, 150);
+    leftLayout->addWidget(inputsView);
     leftLayout->addSpacing(2);
 
     // Outputs Container
@@ -282,26 +279,30 @@ MainWindow::MainWindow(QWidget *parent)
 
     leftLayout->addWidget(outputRow);
 
-    QScrollArea* outputScrollArea = new QScrollArea(this);
-    outputScrollArea->setWidgetResizable(true);
-    outputScrollArea->setFixedHeight(150);
-
-    outputListContainer = new QWidget(this);
-    outputListLayout = new QVBoxLayout(outputListContainer);
-    outputListLayout->setContentsMargins(5, 5, 5, 5);
-    outputListLayout->setSpacing(8);
-    outputListLayout->addStretch();
-
-    outputScrollArea->setWidget(outputListContainer);
-    leftLayout->addWidget(outputScrollArea);
+    outputsModel = new VariableTableModel(false, this);
+    outputsView = createVariableView(outputsModel, 150);
+    leftLayout->addWidget(outputsView);
 
     // Create scene and view
     scene = new QGraphicsScene(this);
     scene->setBackgroundBrush(QColor("#ffffff"));
+    // Items only move while editing, the BSP tree keeps lookups and culling logarithmic
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
 
-    view = new QGraphicsView(scene, this);
+    view = new FsmView(scene, this);
     rightLayout->addWidget(view);
 
+    // Progress of loading a large automaton, the scene is filled in time slices
+    loadProgress = new QProgressBar(this);
+    loadProgress->setMaximumHeight(12);
+    loadProgress->setTextVisible(false);
+    loadProgress->setVisible(false);
+    rightLayout->addWidget(loadProgress);
+
+    loadTimer = new QTimer(this);
+    loadTimer->setInterval(0);
+    connect(loadTimer, &QTimer::timeout, this, &MainWindow::loadNextBatch);
+
     view->setMouseTracking(true);
     view->viewport()->installEventFilter(this);
 
@@ -315,24 +316,11 @@ MainWindow::MainWindow(QWidget *parent)
         if (key.isEmpty())
             return;
 
-        if (internalVarMap.contains(key)) {
+        if (!internalsModel->addVariable(key, val)) {
             QMessageBox::warning(this, "Duplicate Variable", "Variable with this name already exists.");
             return;
         }
 
-        auto* item = new InternalVarItem(key, val, this);
-        connect(item, &InternalVarItem::removeRequested, this, [=](const QString& keyToRemove) {
-            auto it = internalVarMap.find(keyToRemove);
-            if (it != internalVarMap.end()) {
-                internalVarsFlow->removeWidget(it.value());
-                it.value()->deleteLater();
-                internalVarMap.erase(it);
-            }
-        });
-
-        internalVarsFlow->addWidget(item);
-        internalVarMap[key] = item;
-
         envKeyEdit->clear();
         envValueEdit->clear();
     });
@@ -342,36 +330,11 @@ MainWindow::MainWindow(QWidget *parent)
 
         if (name.isEmpty()) return;
 
-        if (inputMap.contains(name)) {
+        if (!inputsModel->addVariable(name, "?")) {
             QMessageBox::warning(this, "Duplicate Input", "Input already exists.");
             return;
         }
 
-        QLineEdit* valField = new QLineEdit("?", this);
-        valField->setReadOnly(true);
-        valField->setFixedWidth(120);
-        valField->setStyleSheet("QLineEdit { border: none; background: transparent; }");
-        
-        QHBoxLayout* row = new QHBoxLayout();
-        QLabel* label = new QLabel(name);
-        QPushButton* removeButton = new QPushButton("✕");
-        removeButton->setFixedSize(20, 20);
-
-        row->addWidget(label);
-        row->addWidget(valField);
-        row->addWidget(removeButton);
-        inputListLayout->insertLayout(inputListLayout->count() - 1, row);
-
-        inputMap[name] = valField;
-
-        connect(removeButton, &QPushButton::clicked, this, [=]() {
-            label->deleteLater();
-            valField->deleteLater();
-            removeButton->deleteLater();
-            row->deleteLater();
-            inputMap.remove(name);
-        });
-
         inputNameEdit->clear();
     });
     
@@ -380,36 +343,11 @@ MainWindow::MainWindow(QWidget *parent)
 
         if (name.isEmpty()) return;
 
-        if (outputMap.contains(name)) {
+        if (!outputsModel->addVariable(name, "?")) {
             QMessageBox::warning(this, "Duplicate Output", "Output already exists.");
             return;
         }
 
-        QLineEdit* valField = new QLineEdit("?", this);
-        valField->setStyleSheet("QLineEdit { border: none; background: transparent; }");
-        valField->setFixedWidth(120);
-        valField->setReadOnly(true);
-
-        QHBoxLayout* row = new QHBoxLayout();
-        QLabel* label = new QLabel(name);
-        QPushButton* removeButton = new QPushButton("✕");
-        removeButton->setFixedSize(20, 20);
-
-        row->addWidget(label);
-        row->addWidget(valField);
-        row->addWidget(removeButton);
-        outputListLayout->insertLayout(outputListLayout->count() - 1, row);
-
-        outputMap[name] = valField;
-
-        connect(removeButton, &QPushButton::clicked, this, [=]() {
-            label->deleteLater();
-            valField->deleteLater();
-            removeButton->deleteLater();
-            row->deleteLater();
-            outputMap.remove(name);
-        });
-
         outputNameEdit->clear();
     });
 
@@ -422,13 +360,64 @@ MainWindow::MainWindow(QWidget *parent)
     ghostCircle->setOpacity(0.5);
     ghostCircle->setVisible(false);
 
-    logBox = new QPlainTextEdit(this);
-    logBox->setReadOnly(true);
-    logBox->setStyleSheet("background-color: #f9f9f9; border: 1px solid #ccc; color: rgb(0,0,0)");
-    logBox->setMaximumHeight(120);
-    logBox->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
-
-    rightLayout->addWidget(logBox);
+    // Log view over a bounded model, rows are single lines so only visible ones are laid out
+    logModel = new LogModel(LogModel::DefaultCapacity, this);
+    logFilter = new LogFilterModel(this);
+    logFilter->setSourceModel(logModel);
+
+    logView = new QListView(this);
+    logView->setModel(logFilter);
+    logView->setUniformItemSizes(true);
+    logView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    logView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    logView->setStyleSheet("background-color: #f9f9f9; border: 1px solid #ccc; color: rgb(0,0,0)");
+    logView->setMaximumHeight(120);
+    logView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+
+    QWidget* logFilterRow = new QWidget(this);
+    QHBoxLayout* logFilterLayout = new QHBoxLayout(logFilterRow);
+    logFilterLayout->setContentsMargins(0, 0, 0, 0);
+    logFilterLayout->setSpacing(6);
+    logElementFilter = new QLineEdit(logFilterRow);
+    logElementFilter->setPlaceholderText("Filter state / transition");
+    logElementFilter->setClearButtonEnabled(true);
+    logVariableFilter = new QLineEdit(logFilterRow);
+    logVariableFilter->setPlaceholderText("Filter changed variable");
+    logVariableFilter->setClearButtonEnabled(true);
+    logFilterLayout->addWidget(logElementFilter);
+    logFilterLayout->addWidget(logVariableFilter);
+
+    connect(logElementFilter, &QLineEdit::textChanged, logFilter, &LogFilterModel::setElementFilter);
+    connect(logVariableFilter, &QLineEdit::textChanged, logFilter, &LogFilterModel::setVariableFilter);
+
+    // Replay timeline, hidden until a journal is opened
+    replayBar = new QWidget(this);
+    QHBoxLayout* replayLayout = new QHBoxLayout(replayBar);
+    replayLayout->setContentsMargins(0, 0, 0, 0);
+    replayLayout->setSpacing(6);
+
+    replaySlider = new QSlider(Qt::Horizontal, replayBar);
+    replayLabel = new QLabel(replayBar);
+    replayLabel->setMinimumWidth(260);
+    QPushButton* closeReplayButton = new QPushButton("✕", replayBar);
+    closeReplayButton->setFixedSize(20, 20);
+
+    replayLayout->addWidget(replaySlider, 1);
+    replayLayout->addWidget(replayLabel);
+    replayLayout->addWidget(closeReplayButton);
+    replayBar->setVisible(false);
+    rightLayout->addWidget(replayBar);
+
+    replayTimer = new QTimer(this);
+    replayTimer->setSingleShot(true);
+    replayTimer->setInterval(16);
+
+    connect(replaySlider, &QSlider::valueChanged, this, &MainWindow::onReplaySliderMoved);
+    connect(replayTimer, &QTimer::timeout, this, &MainWindow::applyReplayPosition);
+    connect(closeReplayButton, &QPushButton::clicked, this, &MainWindow::closeReplay);
+
+    rightLayout->addWidget(logFilterRow);
+    rightLayout->addWidget(logView);
 
     QLabel* injectLabel = new QLabel("Inject input:");
     injectLabel->setContentsMargins(0, 2, 0, 0);  // "Inject input"
@@ -460,13 +449,9 @@ MainWindow::MainWindow(QWidget *parent)
     connect(injectInputButton, &QPushButton::clicked, this, &MainWindow::onInjectInputClicked);
 
 
-    this->connected = false;
-    for (int i = 0; i < 5 && !connected; ++i) {
-        this->connected = networkHandler.connectToServer();
-        if (!connected)
-            QThread::sleep(1);  // small delay between retries
-    }
-    safePrint(std::to_string(this->connected));
+    // An interpreter that is already running accepts at once, there is nothing to wait for
+    this->connected = networkHandler.connectWithBackoff(AttachTimeoutMs);
+    FSM_LOG_DEBUG("Connected to running interpreter: " + std::to_string(this->connected));
     if (this->connected) {
         runButton->setText("⏸");  // Pause icon
         runButton->setToolTip("Pause FSM");
@@ -481,7 +466,7 @@ MainWindow::MainWindow(QWidget *parent)
             networkHandler.sendToHost(empty.toMessageString());
             while (listenerRunning) {
                 std::string buffer = this->networkHandler.recvFromHost();
-                safePrint("Received from server: [" + buffer + "]");
+                FSM_LOG_DEBUG("Received from server: [" + buffer + "]");
                 Message toProcess(buffer);
                 if (toProcess.getType() == EMessageType::STOP) {
                     this->networkHandler.closeConnection();
@@ -497,14 +482,20 @@ MainWindow::MainWindow(QWidget *parent)
     }
 }
 
-void MainWindow::printLog(std::string logMessage) {
-    QString msg = QString::fromStdString(logMessage);
-    logBox->appendPlainText(msg);
+void MainWindow::printLog(const Message& log) {
+    // Follow new records only while the user has not scrolled up
+    QScrollBar* scrollBar = logView->verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    logModel->append(log);
+
+    if (atBottom)
+        logView->scrollToBottom();
 }
 
 void MainWindow::setRunning() {
     runButton->setEnabled(true);
-    safePrint("I am in running");
+    FSM_LOG_DEBUG("GUI switched to running mode.");
 
 }
 
@@ -520,20 +511,36 @@ void MainWindow::showError(std::string errorMessage) {
     QMessageBox::critical(this, "Error", msg);
 }
 
-void MainWindow::showOutput(std::string outputID, std::string outputValue) {
-    QString id = QString::fromStdString(outputID);
-    QString val = QString::fromStdString(outputValue);
-    if (outputMap.contains(id)) {
-        outputMap[id]->setText(val);
-    }
+void MainWindow::showValues(const Message& log) {
+    inputsModel->setValues(log.getInputValues());
+    outputsModel->setValues(log.getOutputValues());
+    internalsModel->setValues(log.getInternalValues());
 }
 
-void MainWindow::showInput(std::string inputID, std::string inputValue) {
-    QString id = QString::fromStdString(inputID);
-    QString val = QString::fromStdString(inputValue);
-    if (inputFieldMap.contains(id)) {
-        inputFieldMap[id]->setText(val);
-    }
+QTableView* MainWindow::createVariableView(VariableTableModel* model, int height) {
+    QTableView* table = new QTableView(this);
+    table->setModel(model);
+    table->setFixedHeight(height);
+    table->setShowGrid(false);
+    table->setSelectionMode(QAbstractItemView::NoSelection);
+    table->setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed);
+    table->setStyleSheet("QTableView { border: 1px solid #ccc; }");
+
+    // Fixed row heights, the view never measures rows it does not show
+    table->verticalHeader()->setVisible(false);
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->verticalHeader()->setDefaultSectionSize(22);
+    table->horizontalHeader()->setSectionResizeMode(VariableTableModel::NameColumn, QHeaderView::Stretch);
+    table->horizontalHeader()->setSectionResizeMode(VariableTableModel::ValueColumn, QHeaderView::Stretch);
+    table->horizontalHeader()->setSectionResizeMode(VariableTableModel::RemoveColumn, QHeaderView::Fixed);
+    table->horizontalHeader()->resizeSection(VariableTableModel::RemoveColumn, 24);
+
+    connect(table, &QTableView::clicked, this, [this, model](const QModelIndex& index) {
+        if (isRunning || index.column() != VariableTableModel::RemoveColumn)
+            return;
+        model->removeVariable(model->nameAt(index.row()));
+    });
+    return table;
 }
 
 void MainWindow::setInterfaceLocked(bool locked) {
@@ -565,31 +572,42 @@ void MainWindow::setInterfaceLocked(bool locked) {
     }
 
     view->setInteractive(!locked);
+
+    // Value tables keep showing live values, only editing is locked
+    for (QTableView* table : {internalsView, inputsView, outputsView}) {
+        table->setEditTriggers(locked ? QAbstractItemView::NoEditTriggers
+                                      : QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed);
+    }
 }
 
 static std::string detectTypeFromValue(const QString& value) {
-    bool okInt = false;
-    bool okFloat = false;
-
-    value.toInt(&okInt);
-    value.toFloat(&okFloat);
-
-    if (okInt) return "int";
-    if (okFloat) return "float";
-    if (value == "true" || value == "false") return "bool";
-
-    return "string";
+    // Same detection as for injected inputs, so the interpreter stores both alike
+    return eValueTypeToString(TypedValue::infer(value.toStdString()).type());
 }
 
 
 MainWindow::~MainWindow() {
-    for (int i = 0; i < stateCount; ++i) {
-        delete stateList[i];
-        stateList[i] = nullptr;
+    // No layout or load result may be queued to a window being destroyed
+    layoutWorker.cancel();
+    if (loadThread.joinable()) {
+        loadThread.join();
     }
     if (listenerThread.joinable()) {
-            listenerThread.join();
+        // The FSMs stop on this thread, it keeps serving them until the listener is done
+        if (!listenerDone) {
+            listenerRunning = false;
+            Message msg;
+            msg.buildStopMessage();
+            networkHandler.sendToHost(msg.toMessageString());
+            networkHandler.closeConnection();
+            networkHandler2.closeConnection();
+        }
+        while (!listenerDone) {
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
         }
+        if (listenerThread.joinable())
+            listenerThread.join();
+    }
 }
 
 void MainWindow::onNewStateButtonClicked() {
@@ -598,13 +616,9 @@ void MainWindow::onNewStateButtonClicked() {
 }
 
 void MainWindow::clearHighlights() {
-    for (QGraphicsItem* item : scene->items()) {
-        if (auto* state = dynamic_cast<StateItem*>(item)) {
-            state->setActive(false);
-        } else if (auto* trans = dynamic_cast<TransitionItem*>(item)) {
-            trans->setActive(false);
-        }
-    }
+    // highlightItem keeps at most one item active
+    if (lastActive != nullptr)
+        lastActive->setActive(false);
 
     lastActive = nullptr;
     // lastActiveTransition = nullptr;
@@ -616,6 +630,10 @@ void MainWindow::onStopClicked() {
     networkHandler.sendToHost(msg.toMessageString());
 
     clearHighlights();
+    // The tables show the declared values again, the save path never sees live values
+    inputsModel->clearLiveValues();
+    outputsModel->clearLiveValues();
+    internalsModel->clearLiveValues();
 
     if (fsm) {
         delete fsm;
@@ -641,9 +659,7 @@ void MainWindow::onRunClicked() {
             setInterfaceLocked(true);
 
             inputComboBox->clear();
-            for (const auto& name : inputMap.keys()) {
-                inputComboBox->addItem(name);
-            }
+            inputComboBox->addItems(inputsModel->names());
 
             isRunning = true;
             runButton->setText("⏸");  // Pause icon
@@ -656,25 +672,29 @@ void MainWindow::onRunClicked() {
             if (!controller) {
                 controller = new GuiController(this);
             }
-            // Check if listener thread is already running, if not, create one
+            // Each step starts on the readiness of the previous one: listener bound,
+            // monitor registered, then the FSM is sent
             if (!listenerRunning) {
+                // A listener that already returned may not be joined yet
+                if (listenerThread.joinable() && listenerDone)
+                    listenerThread.join();
                 listenerRunning = true;
-                QTimer::singleShot(900, this, [this]() {
-                    this->connected = networkHandler2.connectToServer();
-                    Message empty;
-                    networkHandler2.sendToHost(empty.toMessageString());
-                });
+                listenerDone = false;
                 listenerThread = std::thread([this]() {
-                    this->networkHandler.listen(8080);
+                    this->networkHandler.listen(8080, [this](bool bound) {
+                        QMetaObject::invokeMethod(this, [this, bound]() {
+                            onListenerReady(bound);
+                        }, Qt::QueuedConnection);
+                    });
+                    // The listener stops only after the FSMs did, on the GUI thread, so the
+                    // GUI thread never blocks on it and joins it once it is done
+                    listenerDone = true;
+                    QMetaObject::invokeMethod(this, &MainWindow::onListenerStopped, Qt::QueuedConnection);
                 });
-                QTimer::singleShot(1000, this, &MainWindow::startReceivingMessages);
+            } else {
+                // Attached to a running interpreter, the connection is already open
+                sendInitialMessage();
             }
-            QTimer::singleShot(750, this, [this]() {
-                this->connected = networkHandler.connectToServer();
-            });
-            
-
-            QTimer::singleShot(1000, this, &MainWindow::sendInitialMessage);
             
         } else {
             // Pause FSM logic
@@ -684,17 +704,78 @@ void MainWindow::onRunClicked() {
             // Trigger stop logic to pause FSM
             onStopClicked();
             
-            // Set the listener flag to false and join the thread
+            // Set the listener flag to false, the thread is joined once it stopped
             listenerRunning = false;
             this->networkHandler2.closeConnection();
-            if (listenerThread.joinable()) {
-                listenerThread.join();  // Wait for the listener thread to finish
+            if (listenerThread.joinable() && !listenerDone) {
+                runButton->setEnabled(false);
             }
         }
 }
 
+void MainWindow::onListenerStopped() {
+    if (listenerThread.joinable())
+        listenerThread.join();
+    if (!isRunning)
+        runButton->setEnabled(true);
+}
+
+void MainWindow::onListenerReady(bool bound) {
+    if (!bound) {
+        abortRun("Cannot start the interpreter, port 8080 is in use.");
+        return;
+    }
+
+    this->connected = networkHandler2.connectWithBackoff(ConnectTimeoutMs);
+    if (!this->connected) {
+        abortRun("Cannot connect to the interpreter.");
+        return;
+    }
+    startReceivingMessages();
+}
+
+void MainWindow::connectAndLoad() {
+    this->connected = networkHandler.connectWithBackoff(ConnectTimeoutMs);
+    if (!this->connected) {
+        abortRun("Cannot connect to the interpreter.");
+        return;
+    }
+    sendInitialMessage();
+}
+
+void MainWindow::abortRun(const std::string& error) {
+    // The listener thread is joined by onListenerStopped, which enables Run again
+    listenerRunning = false;
+    networkHandler.closeConnection();
+    networkHandler2.closeConnection();
+    networkHandler.stopListening();
+
+    isRunning = false;
+    runButton->setText("▶");  // Play icon
+    runButton->setToolTip("Run FSM");
+    runButton->setEnabled(listenerDone);
+    setInterfaceLocked(false);
+    showError(error);
+}
+
 void MainWindow::startReceivingMessages() {
         std::thread([this]() {
+            // The server registers the client with its first message and answers a
+            // subscription with ACCEPT, after it the client receives every broadcast
+            Message subscribe;
+            subscribe.buildSubscribeMessage(Subscription());
+            networkHandler2.sendToHost(subscribe.toMessageString());
+            bool registered = false;
+            while (listenerRunning && !registered) {
+                std::string buffer = this->networkHandler2.recvFromHost();
+                if (buffer.empty())
+                    return;
+                registered = Message(buffer).getType() == EMessageType::ACCEPT;
+            }
+            if (!registered)
+                return;
+            QMetaObject::invokeMethod(this, &MainWindow::connectAndLoad, Qt::QueuedConnection);
+
             while (listenerRunning) {
                 std::string buffer = this->networkHandler2.recvFromHost();
                 Message toProcess(buffer);
@@ -711,6 +792,77 @@ void MainWindow::startReceivingMessages() {
 
 
 
+void MainWindow::onReplayClicked() {
+    QString directory = QFileDialog::getExistingDirectory(this, "Select Journal Directory",
+        QString::fromStdString(JournalWriter::directoryFromEnvironment()));
+    if (directory.isEmpty())
+        return;
+
+    auto reader = std::make_unique<JournalReader>(directory.toStdString());
+    int64_t firstMs = 0;
+    int64_t lastMs = 0;
+    if (!reader->open() || !reader->timeBounds(firstMs, lastMs)) {
+        QMessageBox::warning(this, "Replay Failed", "No recorded execution found in " + directory + ".");
+        return;
+    }
+
+    replayReader = std::move(reader);
+    replayStartMs = firstMs;
+    replayShownSeq = UINT64_MAX;
+
+    // Long recordings are mapped onto the int range of the slider
+    int64_t span = lastMs - firstMs;
+    replayStepMs = span / INT_MAX + 1;
+
+    replaySlider->blockSignals(true);
+    replaySlider->setRange(0, static_cast<int>(span / replayStepMs));
+    replaySlider->setValue(0);
+    replaySlider->setPageStep(std::max(1, replaySlider->maximum() / 100));
+    replaySlider->blockSignals(false);
+    replayBar->setVisible(true);
+
+    clearHighlights();
+    applyReplayPosition();
+}
+
+void MainWindow::onReplaySliderMoved(int) {
+    // Seeks run at most once per frame however fast the slider is dragged
+    if (!replayTimer->isActive())
+        replayTimer->start();
+}
+
+void MainWindow::applyReplayPosition() {
+    if (!replayReader)
+        return;
+
+    int64_t timestampMs = replayStartMs + static_cast<int64_t>(replaySlider->value()) * replayStepMs;
+    JournalRecord record;
+    if (!replayReader->stateAt(timestampMs, record) || record.seq == replayShownSeq)
+        return;
+    replayShownSeq = record.seq;
+
+    try {
+        highlightItem(true, getActivableItem(record.elementType, record.currentElement));
+    } catch (const std::runtime_error&) {
+        // The loaded diagram does not contain the recorded element
+        clearHighlights();
+    }
+
+    inputsModel->setValues(record.inputValues);
+    outputsModel->setValues(record.outputValues);
+
+    QString time = QDateTime::fromMSecsSinceEpoch(record.timestampMs).toString("yyyy-MM-dd hh:mm:ss.zzz");
+    replayLabel->setText(time + "  #" + QString::number(record.seq) + "  " +
+        QString::fromStdString(record.currentElement));
+}
+
+void MainWindow::closeReplay() {
+    replayTimer->stop();
+    replayReader.reset();
+    replayBar->setVisible(false);
+    clearHighlights();
+}
+
 void MainWindow::sendInitialMessage() {
         Message msg;
         auto name = this->automatonName.toStdString();
@@ -722,9 +874,9 @@ void MainWindow::onSaveClicked() {
     fsm = new FSM(this->automatonName.toStdString());
 
     // Add internal variables
-    for (auto it = internalVarMap.begin(); it != internalVarMap.end(); ++it) {
-        QString key = it.key();
-        QString value = it.value()->getValue();
+    for (int row = 0; row < internalsModel->rowCount(); ++row) {
+        QString key = internalsModel->nameAt(row);
+        QString value = internalsModel->value(key);
 
         InternalVar var;
         var.setName(key.toStdString());
@@ -738,10 +890,8 @@ void MainWindow::onSaveClicked() {
     QSet<QString> outputSet;
     QRegularExpression outputRegex(R"(output\(\s*["'](\w+)["'])");
 
-    for (int index = 0; index < stateCount; ++index) {
-        if (!stateList[index]) continue;
-
-        std::shared_ptr<State> statePtr = std::make_shared<State>(*stateList[index]);
+    for (const auto& state : states) {
+        std::shared_ptr<State> statePtr = std::make_shared<State>(*state);
         fsm->addState(statePtr);
 
         QString action = QString::fromStdString(statePtr->getActionCode());
@@ -822,11 +972,13 @@ void MainWindow::onUploadClicked() {
 
 void MainWindow::onClearClicked() {
     scene->clear();  // Remove all visual items
-    stateCount = 0;
-
-    for (int i = 0; i < MAX_STATES; ++i) {
-        stateList[i] = nullptr;
-    }
+    states.clear();
+    lastActive = nullptr;
+    stateItemIndex.clear();
+    transitionItemIndex.clear();
+    logModel->clear();
+    layoutWorker.cancel();
+    cancelLoading();
 
     // Reset any in-progress transitions or ghost elements
     transitionStart = nullptr;
@@ -1015,16 +1167,14 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
 
                 Transition t(src, dst, inputToSet, condToSet, timeoutToSet, this->TransitionId);
 
-                for (int i = 0; i < stateCount; ++i) {
-                    if (stateList[i]->getName() == src) {
-                        stateList[i]->addTransition(t);
-                        break;
-                    }
+                if (std::shared_ptr<State> source = states.find(src)) {
+                    source->addTransition(t);
                 }
 
                 QString labelText = input + " / " + cond + " / " + timeout;
                 currentLine->setLabel(labelText);
                 currentLine->markConfirmed();
+                transitionItemIndex.insert(currentLine->getId(), currentLine);
         
             } else {
                 // Not a valid target: remove line
@@ -1070,27 +1220,17 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
                 if (act == setInit) {
                     bool newStateInit = !state->isInitial();
 
-                    // Reset all other StateItem visuals to non-initial
-                    for (QGraphicsItem* item : scene->items()) {
-                        auto* s = dynamic_cast<StateItem*>(item);
-                        if (s && s != state && s->isInitial()) {
-                            s->setInitial(false);
-                        }
-                    }
-                
-                    // Deselect the old initial
-                    for (int i = 0; i < stateCount; ++i) {
-                        if (stateList[i]->isInitialState()) {
-                            stateList[i]->setInitial(false);
+                    // Reset the previous initial StateItem visual to non-initial
+                    if (newStateInit) {
+                        QString previous = QString::fromStdString(states.getInitial());
+                        StateItem* old = stateItemIndex.value(previous, nullptr);
+                        if (old && old != state) {
+                            old->setInitial(false);
                         }
                     }
                 
-                    // Set this state as initial in the logical model
-                    for (int i = 0; i < stateCount; ++i) {
-                        if (stateList[i]->getName() == state->getName().toStdString()) {
-                            stateList[i]->setInitial(newStateInit);
-                        }
-                    }
+                    // Set this state as initial in the logical model, the table deselects the old one
+                    states.setInitial(state->getName().toStdString(), newStateInit);
                 
                     // Update the visual StateItem
                     state->setInitial(newStateInit);
@@ -1111,14 +1251,11 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
 
                 else if (act == editAct) {
                     // Lookup corresponding FSM state object
-                    for (int i = 0; i < stateCount; ++i) {
-                        if (stateList[i] && stateList[i]->getName() == state->getName().toStdString()) {
-                            QString current = QString::fromStdString(stateList[i]->getActionCode());
-                            QString updated = askToEditAction(current);
-                            if (!updated.isEmpty()) {
-                                stateList[i]->setActionCode(updated.toStdString());
-                            }
-                            break;
+                    if (std::shared_ptr<State> logic = states.find(state->getName().toStdString())) {
+                        QString current = QString::fromStdString(logic->getActionCode());
+                        QString updated = askToEditAction(current);
+                        if (!updated.isEmpty()) {
+                            logic->setActionCode(updated.toStdString());
                         }
                     }
                 }
@@ -1141,23 +1278,17 @@ bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
             if (name.length() > 8) name = name.left(8);
             std::string nameStr = name.toStdString();
         
-            for (int i = 0; i < stateCount; ++i) {
-                if (stateList[i]->getName() == nameStr) {
-                    QMessageBox::warning(this, "Creation Failed",
-                        "State with the name \"" + name + "\" already exists.");
-                    return true;  // Duplicate, keep ghost
-                }
-            }
-        
-            if (stateCount >= MAX_STATES) {
-                QMessageBox::warning(this, "Creation Failed", "Maximum number of states reached.");
-                return true;
+            if (states.contains(nameStr)) {
+                QMessageBox::warning(this, "Creation Failed",
+                    "State with the name \"" + name + "\" already exists.");
+                return true;  // Duplicate, keep ghost
             }
         
             StateItem *state = new StateItem(finalPos, name);
             scene->addItem(state);
+            stateItemIndex.insert(name, state);
         
-            stateList[stateCount++] = new State(name.toStdString(), actionCode.toStdString());
+            states.add(std::make_shared<State>(nameStr, actionCode.toStdString()));
         
            
         
@@ -1185,41 +1316,31 @@ void MainWindow::onInjectInputClicked() {
 
     if (inputName.isEmpty()) return;
 
-    if (!inputMap.contains(inputName)) {
+    if (!inputsModel->contains(inputName)) {
         QMessageBox::warning(this, "Injection Failed", "No input field found for: " + inputName);
         return;
     }
 
-    QLineEdit* field = inputMap.value(inputName, nullptr);
-    if (!field) {
-        QMessageBox::critical(this, "Error", "Input mapping broken for: " + inputName);
-        return;
-    }
-
     qDebug() << "Injecting input:" << inputName << " = " << value;
-    field->setText(value);  // Set injected value visibly
+    inputsModel->setValue(inputName, value);  // Set injected value visibly
 
     Message msg;
-    msg.buildInputMessage(inputName.toStdString(), value.toStdString());
+    msg.buildInputMessage(inputName.toStdString(), TypedValue::infer(value.toStdString()));
     this->networkHandler.sendToHost(msg.toMessageString());  // or socket->sendMessage(msg);
 }
 
 IActivable& MainWindow::getActivableItem(EItemType type, std::string itemID) {
-    QString qid = QString::fromStdString(itemID);
-
-    for (QGraphicsItem* item : scene->items()) {
-        if (type == EItemType::STATE) {
-            if (auto* state = dynamic_cast<StateItem*>(item)) {
-                if (state->getName() == qid) {
-                    return *state;  // Return reference to the state item
-                }
-            }
-        } else if (type == EItemType::TRANSITION) {
-            if (auto* transition = dynamic_cast<TransitionItem*>(item)) {
-                if (QString::fromStdString(std::to_string(transition->getId())) == qid) { 
-                    return *transition;
-                }
-            }
+    if (type == EItemType::STATE) {
+        StateItem* state = stateItemIndex.value(QString::fromStdString(itemID), nullptr);
+        if (state) {
+            return *state;  // Return reference to the state item
+        }
+    } else if (type == EItemType::TRANSITION) {
+        bool ok = false;
+        int id = QString::fromStdString(itemID).toInt(&ok);
+        TransitionItem* transition = ok ? transitionItemIndex.value(id, nullptr) : nullptr;
+        if (transition) {
+            return *transition;
         }
     }
 
@@ -1234,137 +1355,113 @@ void MainWindow::loadFSMFromJson(std::string pathToJson) {
     QDir dir(QDir(examplesPath).absolutePath());
    
     QString filePath = dir.filePath(QString::fromStdString(pathToJson));
-    
 
-
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        QMessageBox::critical(this, "Error", "Unable to open selected file.");
-        return;
+    // Parsing and building the model run on a worker, the window stays responsive
+    cancelLoading();
+    uint64_t generation = loadGeneration;
+    if (loadThread.joinable()) {
+        loadThread.join();
     }
-  
-    QByteArray fileData = file.readAll();
-    file.close();
-    
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(fileData, &parseError);
-    if (parseError.error != QJsonParseError::NoError) {
-        QMessageBox::critical(this, "Parse Error", "Invalid JSON format.");
+
+    loadThread = std::thread([this, generation, filePath]() {
+        FSM* loaded = nullptr;
+        auto model = std::make_shared<StateTable>();
+        QString errorTitle = "Error";
+        QString error;
+
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = "Unable to open selected file.";
+        } else {
+            QJsonParseError parseError;
+            QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+            file.close();
+            if (parseError.error != QJsonParseError::NoError) {
+                errorTitle = "Parse Error";
+                error = "Invalid JSON format.";
+            } else {
+                JsonLoader loader;
+                loaded = loader.fromJson(doc);
+                if (!loaded) {
+                    error = "Failed to load FSM from JSON.";
+                }
+            }
+        }
+
+        // The editor works on its own copies of the states
+        if (loaded) {
+            for (const auto& state : loaded->getStates()) {
+                model->add(std::make_shared<State>(*state));
+            }
+            for (const auto& t : loaded->getTransitions()) {
+                std::shared_ptr<State> source = model->find(t->getSource());
+                if (source && model->contains(t->getTarget())) {
+                    source->addTransition(*t);
+                }
+            }
+        }
+
+        QMetaObject::invokeMethod(this, [this, generation, loaded, model, errorTitle, error]() {
+            onFsmParsed(generation, loaded, model, errorTitle, error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onFsmParsed(uint64_t generation, FSM* loaded, std::shared_ptr<StateTable> model,
+                             const QString& errorTitle, const QString& error) {
+    // Another load or a clear happened while parsing
+    if (generation != loadGeneration) {
+        delete loaded;
         return;
     }
-
-    JsonLoader loader;
-    FSM* loadedFsm = loader.fromJson(doc);
-    this->fsm = loadedFsm;
-   
-    if (!loadedFsm) {
-        QMessageBox::critical(this, "Error", "Failed to load FSM from JSON.");
+    if (!loaded) {
+        QMessageBox::critical(this, errorTitle, error);
         return;
     }
+    this->fsm = loaded;
 
-    // Pass loadedFsm to your existing population logic
+    // Pass loaded to your existing population logic
     onClearClicked();
+    states = std::move(*model);
 
-    // Clear old internal variable widgets
-    for (auto it = internalVarMap.begin(); it != internalVarMap.end(); ++it) {
-        internalVarsFlow->removeWidget(it.value());
-        it.value()->deleteLater();
+    // Populate internal variables, inputs and outputs
+    internalsModel->clear();
+    for (const auto& var : loaded->getInternalVars()) {
+        internalsModel->addVariable(QString::fromStdString(var.getName()),
+                                    QString::fromStdString(var.getInitialValue()));
     }
-    internalVarMap.clear();
-
-    // Populate internal variables
-    for (const auto& var : loadedFsm->getInternalVars()) {
-        QString key = QString::fromStdString(var.getName());
-        QString val = QString::fromStdString(var.getInitialValue());
-
-        auto* item = new InternalVarItem(key, val, this);
-        connect(item, &InternalVarItem::removeRequested, this, [=](const QString& keyToRemove) {
-            auto it = internalVarMap.find(keyToRemove);
-            if (it != internalVarMap.end()) {
-                internalVarsFlow->removeWidget(it.value());
-                it.value()->deleteLater();
-                internalVarMap.erase(it);
-            }
-        });
-        
-        internalVarsFlow->addWidget(item);
-        internalVarMap[key] = item;
-    }
-    // Populate inputs
-    for (const auto& name : loadedFsm->getInputNames()) {
-        QString qName = QString::fromStdString(name);
-        QLineEdit* valField = new QLineEdit(this);
-        valField->setFixedWidth(120);
-        QHBoxLayout* row = new QHBoxLayout();
-        QLabel* label = new QLabel(qName + ":");
-        QPushButton* removeButton = new QPushButton("✕");
-        removeButton->setFixedSize(20, 20);
-
-        row->addWidget(label);
-        row->addWidget(valField);
-        row->addWidget(removeButton);
-        inputListLayout->insertLayout(inputListLayout->count() - 1, row);
-        inputMap[qName] = valField;
-
-        connect(removeButton, &QPushButton::clicked, this, [=]() {
-            label->deleteLater();
-            valField->deleteLater();
-            removeButton->deleteLater();
-            row->deleteLater();
-            inputMap.remove(qName);
-        });
+
+    inputsModel->clear();
+    for (const auto& name : loaded->getInputNames()) {
+        inputsModel->addVariable(QString::fromStdString(name), "");
     }
-    
     inputComboBox->clear();
-    for (const QString& inputName : inputMap.keys()) {
-        inputComboBox->addItem(inputName);
-    }
+    inputComboBox->addItems(inputsModel->names());
 
-    // Populate outputs
-    for (const auto& name : loadedFsm->getOutputNames()) {
-        QString qName = QString::fromStdString(name);
-        QLineEdit* valField = new QLineEdit("?", this);
-        valField->setReadOnly(true);
-        valField->setFixedWidth(120);
-        valField->setStyleSheet("QLineEdit { border: none; background: transparent; }");
-
-        QHBoxLayout* row = new QHBoxLayout();
-        QLabel* label = new QLabel(qName + ":");
-        QPushButton* removeButton = new QPushButton("✕");
-        removeButton->setFixedSize(20, 20);
-
-        row->addWidget(label);
-        row->addWidget(valField);
-        row->addWidget(removeButton);
-        outputListLayout->insertLayout(outputListLayout->count() - 1, row);
-        outputMap[qName] = valField;
-
-        connect(removeButton, &QPushButton::clicked, this, [=]() {
-            label->deleteLater();
-            valField->deleteLater();
-            removeButton->deleteLater();
-            row->deleteLater();
-            outputMap.remove(qName);
-        });
+    outputsModel->clear();
+    for (const auto& name : loaded->getOutputNames()) {
+        outputsModel->addVariable(QString::fromStdString(name), "?");
     }
 
-    // Populate states and transitions
+    // Rebuilding the BSP tree after every insert is quadratic, index once at the end
+    // (Qt picks the tree depth from the item count when it is rebuilt)
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    // Grid positions of states
     int index = 0;
-    int numStates = static_cast<int>(loadedFsm->getStates().size());
-    const int cols = std::ceil(std::sqrt(numStates)); // square
+    int numStates = static_cast<int>(loaded->getStates().size());
+    const int cols = std::max(1, static_cast<int>(std::ceil(std::sqrt(numStates)))); // square
     const int spacing = 180;
-    const int stateSize = CircleDiameter;
     
     // Calculate starting point (center the grid)
-    int totalCols = std::min(cols, static_cast<int>(loadedFsm->getStates().size()));
-    int totalRows = (loadedFsm->getStates().size() + cols - 1) / cols;
+    int totalCols = std::min(cols, numStates);
+    int totalRows = (numStates + cols - 1) / cols;
     QPointF center = view->mapToScene(view->viewport()->rect().center());
     QPointF start = center - QPointF((totalCols - 1) * spacing / 2, (totalRows - 1) * spacing / 2);
-   
-    for (const auto& pair : loadedFsm->getStates()) {
-        std::shared_ptr<State> state = pair.second;
-        QString qName = QString::fromStdString(state->getName());
 
+    // Queue the items nearest to the visible center first, a transition right after its farther state
+    QHash<QString, qreal> distanceOf;
+    for (const std::shared_ptr<State>& state : loaded->getStates()) {
         int row = index / cols;
         int col = index % cols;
         
@@ -1372,43 +1469,150 @@ void MainWindow::loadFSMFromJson(std::string pathToJson) {
         QRandomGenerator::global()->bounded(-10, 10));
         QPointF pos = start + QPointF(col * spacing, row * spacing) + jitter;
 
-        StateItem* stateItem = new StateItem(pos, qName);
-        stateItem->setInitial(state->isInitialState());
-        stateItem->setFinal(state->isFinalState());
-        scene->addItem(stateItem);
-
-        stateList[stateCount++] = new State(*state);
+        qreal distance = QLineF(pos, center).length();
+        distanceOf.insert(QString::fromStdString(state->getName()), distance);
+        loadQueue.push_back({distance, state, nullptr, pos});
         ++index;
     }
+    for (const auto& t : loaded->getTransitions()) {
+        auto from = distanceOf.find(QString::fromStdString(t->getSource()));
+        auto to = distanceOf.find(QString::fromStdString(t->getTarget()));
+        if (from != distanceOf.end() && to != distanceOf.end()) {
+            loadQueue.push_back({std::max(from.value(), to.value()), nullptr, t, QPointF()});
+        }
+    }
+    std::stable_sort(loadQueue.begin(), loadQueue.end(), [](const PendingItem& a, const PendingItem& b) {
+        return a.distance < b.distance;
+    });
 
-    for (const auto& t : loadedFsm->getTransitions()) {
-        QString from = QString::fromStdString(t->getSource());
-        QString to   = QString::fromStdString(t->getTarget());
-        int id = t->getId();
-        StateItem* sourceItem = nullptr;
-        StateItem* targetItem = nullptr;
-
-        for (QGraphicsItem* item : scene->items()) {
-            auto* s = dynamic_cast<StateItem*>(item);
-            if (!s) continue;
+    loadCenter = center;
+    loadNext = 0;
+    loadProgress->setRange(0, static_cast<int>(loadQueue.size()));
+    loadProgress->setValue(0);
+    loadProgress->setVisible(true);
+    loadTimer->start();
+}
 
-            if (s->getName() == from) sourceItem = s;
-            if (s->getName() == to)   targetItem = s;
+void MainWindow::loadNextBatch() {
+    QElapsedTimer slice;
+    slice.start();
+
+    while (loadNext < loadQueue.size() && slice.elapsed() < LoadSliceMs) {
+        const PendingItem& item = loadQueue[loadNext++];
+
+        if (item.state) {
+            QString qName = QString::fromStdString(item.state->getName());
+            StateItem* stateItem = new StateItem(item.pos, qName);
+            stateItem->setInitial(item.state->isInitialState());
+            stateItem->setFinal(item.state->isFinalState());
+            scene->addItem(stateItem);
+            stateItemIndex.insert(qName, stateItem);
+            continue;
         }
 
+        const std::shared_ptr<Transition>& t = item.transition;
+        int id = t->getId();
+        StateItem* sourceItem = stateItemIndex.value(QString::fromStdString(t->getSource()), nullptr);
+        StateItem* targetItem = stateItemIndex.value(QString::fromStdString(t->getTarget()), nullptr);
+
         if (sourceItem && targetItem) {
             auto* line = new TransitionItem(sourceItem->sceneCenter(), targetItem->sceneCenter(), nullptr, id);
             line->setLabel(QString::fromStdString(t->getInputEvent()) +" / "+ QString::fromStdString(t->getGuardCondition()) + " / " + QString::fromStdString(t->getDelay()));
             line->markConfirmed();
             scene->addItem(line);
+            transitionItemIndex.insert(id, line);
 
-            for (int i = 0; i < stateCount; ++i) {
-                if (stateList[i]->getName() == t->getSource()) {
-                    stateList[i]->addTransition(*t);
-                }
-            }
+            // Transitions created later must not reuse a loaded id
+            this->TransitionId = std::max(this->TransitionId, id);
         }
     }
+
+    loadProgress->setValue(static_cast<int>(loadNext));
+    if (loadNext < loadQueue.size()) {
+        return;  // the timer fires again once pending events are processed
+    }
+
+    loadTimer->stop();
+    loadQueue.clear();
+    loadProgress->setVisible(false);
+
+    const qreal margin = 180;
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    scene->setSceneRect(scene->sceneRect().united(scene->itemsBoundingRect().adjusted(-margin, -margin, margin, margin)));
+
+    // The grid is only a placeholder until the layout worker finishes
+    startAutoLayout(loadCenter);
     QMessageBox::information(this, "Upload Complete", "FSM loaded successfully.");
 }
 
+void MainWindow::cancelLoading() {
+    ++loadGeneration;
+    if (!loadTimer || !loadTimer->isActive()) {
+        return;
+    }
+    loadTimer->stop();
+    loadQueue.clear();
+    loadNext = 0;
+    loadProgress->setVisible(false);
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+}
+
+void MainWindow::startAutoLayout(QPointF center) {
+    if (!fsm)
+        return;
+
+    // Snapshot the graph here, the worker never touches the FSM or the scene
+    std::vector<QString> names;
+    std::vector<LayoutPoint> initial;
+    QHash<QString, size_t> indexOf;
+    for (const auto& state : fsm->getStates()) {
+        QString name = QString::fromStdString(state->getName());
+        StateItem* item = stateItemIndex.value(name, nullptr);
+        if (!item)
+            continue;
+        indexOf.insert(name, names.size());
+        names.push_back(name);
+        initial.push_back({item->pos().x() - center.x(), item->pos().y() - center.y()});
+    }
+
+    std::vector<LayoutEdge> edges;
+    for (const auto& t : fsm->getTransitions()) {
+        auto from = indexOf.find(QString::fromStdString(t->getSource()));
+        auto to = indexOf.find(QString::fromStdString(t->getTarget()));
+        if (from != indexOf.end() && to != indexOf.end())
+            edges.emplace_back(from.value(), to.value());
+    }
+
+    layoutWorker.start(ForceLayout(names.size(), std::move(edges)), std::move(initial),
+        [this, names, center](uint64_t generation, std::vector<LayoutPoint> positions) {
+            QMetaObject::invokeMethod(this, [this, generation, names, positions = std::move(positions), center]() {
+                applyLayout(generation, names, positions, center);
+            }, Qt::QueuedConnection);
+        });
+}
+
+void MainWindow::applyLayout(uint64_t generation, const std::vector<QString>& names,
+                             const std::vector<LayoutPoint>& positions, QPointF center) {
+    // A newer load replaced the graph while this layout was running
+    if (generation != layoutWorker.generation() || !fsm)
+        return;
+
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    for (size_t i = 0; i < names.size() && i < positions.size(); ++i) {
+        if (StateItem* item = stateItemIndex.value(names[i], nullptr))
+            item->setPos(center + QPointF(positions[i].x, positions[i].y));
+    }
+
+    for (const auto& t : fsm->getTransitions()) {
+        TransitionItem* line = transitionItemIndex.value(t->getId(), nullptr);
+        StateItem* source = stateItemIndex.value(QString::fromStdString(t->getSource()), nullptr);
+        StateItem* target = stateItemIndex.value(QString::fromStdString(t->getTarget()), nullptr);
+        if (line && source && target)
+            line->updateLine(source->sceneCenter(), target->sceneCenter());
+    }
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+
+    const qreal margin = CircleDiameter * 2;
+    scene->setSceneRect(scene->sceneRect().united(scene->itemsBoundingRect().adjusted(-margin, -margin, margin, margin)));
+}
+
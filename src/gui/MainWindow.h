@@ -26,17 +26,28 @@
 #include <QGraphicsEllipseItem>
 #include <QSet>
 #include <QMap>
-#include "InternalVarItem.h"
-#include "QFlowLayout.h"
+#include <QHash>
 #include "FSM.h"
 #include <QPlainTextEdit>
+#include <QListView>
+#include <QTableView>
 #include <QLineEdit>
 #include <QComboBox>
+#include <QSlider>
+#include <QTimer>
+#include <QProgressBar>
+#include <memory>
 #include "IMainWindow.h"
+#include "FsmView.h"
+#include "LogModel.h"
+#include "LogFilterModel.h"
+#include "VariableTableModel.h"
 #include "../io/JsonLoader.h"
 #include "../networkHandler/NetworkHandler.h"
 #include "../common/EMessageType.h"
 #include "../controllers/guiController/GuiController.h"
+#include "../journal/Journal.h"
+#include "../layout/LayoutWorker.h"
 
 /**
  * @class MainWindow
@@ -67,9 +78,9 @@ public:
 
     /**
      * @brief Appends a message to the debug log view.
-     * @param logMessage Text message to log.
+     * @param log LOG message to append.
      */
-    void printLog(std::string logMessage) override;
+    void printLog(const Message& log) override;
 
     /**
      * @brief Highlights or unhighlights a state or transition in the diagram.
@@ -101,18 +112,10 @@ public:
     void showError(std::string errorMessage) override;
 
     /**
-     * @brief Updates the value of a monitored output in the GUI.
-     * @param outputID ID of the output.
-     * @param outputValue New value as string.
+     * @brief Updates the input, output and internal variable tables with the values of a LOG message.
+     * @param log The LOG message carrying the values.
      */
-    void showOutput(std::string outputID, std::string outputValue) override;
-
-    /**
-     * @brief Updates the value of an input field in the GUI.
-     * @param inputID ID of the input.
-     * @param inputValue New value as string.
-     */
-    void showInput(std::string inputID, std::string inputValue) override;
+    void showValues(const Message& log) override;
 
     /**
      * @brief Loads a saved FSM model from a JSON file.
@@ -123,6 +126,9 @@ public:
     std::thread listenerThread;                ///< Thread listening for runtime messages
     std::thread recvThread;                    ///< Additional thread for receiving async messages
     std::atomic<bool> listenerRunning = false; ///< Whether the listener is active
+    std::atomic<bool> listenerDone = true;     ///< Whether listen() of listenerThread returned
+    static constexpr int ConnectTimeoutMs = 2000; ///< Connection attempts to a bound listener
+    static constexpr int AttachTimeoutMs = 500;   ///< Connection attempts to an interpreter running at startup
     int TransitionId = 1;                      ///< ID counter for transitions
 
 protected:
@@ -143,7 +149,15 @@ private slots:
     void onSaveClicked();                 ///< Slot for saving the FSM
     void onUploadClicked();               ///< Slot for uploading and loading a saved FSM
     void sendInitialMessage();            ///< Sends initial request to backend
-    void startReceivingMessages();        ///< Begins asynchronous message reception
+    void startReceivingMessages();        ///< Registers for broadcasts, then receives them asynchronously
+    void onListenerReady(bool bound);     ///< Connects the monitor once the listener is bound
+    void connectAndLoad();                ///< Connects to the interpreter and sends the FSM
+    void onListenerStopped();             ///< Joins the listener thread once listen() returned
+    void abortRun(const std::string& error); ///< Stops the listener and unlocks the UI after a failed start
+    void onReplayClicked();               ///< Slot for opening a recorded journal for replay
+    void onReplaySliderMoved(int value);  ///< Slot for scheduling a seek to the slider position
+    void applyReplayPosition();           ///< Shows the recorded state at the pending slider position
+    void closeReplay();                   ///< Closes the replayed journal and hides the timeline
 
     /**
      * @brief Prompts the user to define transition properties.
@@ -166,9 +180,7 @@ private slots:
 
 private:
     FSM* fsm = nullptr;                         ///< Pointer to the FSM logic model
-    static const int MAX_STATES = 100;
-    State* stateList[MAX_STATES];               ///< Fixed-size array of state logic
-    int stateCount = 0;                         ///< Number of currently added states
+    StateTable states;                          ///< State logic of the edited automaton, indexed by name
     bool connectingMode = false;                ///< Whether user is creating a transition
     bool isRunning = false;                     ///< Whether FSM is running
 
@@ -178,30 +190,27 @@ private:
     StateItem* transitionStart = nullptr;       ///< Pointer to state where transition starts
     TransitionItem* currentLine = nullptr;      ///< Pointer to temporary transition line
 
-    QWidget* inputListContainer;                ///< Container for list of inputs
-    QVBoxLayout* inputListLayout;               ///< Layout managing input rows
-
     QLabel* stateLabel = nullptr;               ///< Optional state indicator label
 
     QGraphicsScene* scene = nullptr;            ///< Graphics scene for diagram
-    QGraphicsView* view = nullptr;              ///< Viewport showing the FSM scene
-    QWidget* internalVarsContainer;             ///< Container widget for internal vars
-    QFlowLayout* internalVarsFlow;              ///< Layout for internal variable chips
-    QMap<QString, InternalVarItem*> internalVarMap; ///< Map of internal variable name to widgets
+    FsmView* view = nullptr;                    ///< Viewport showing the FSM scene
+    VariableTableModel* internalsModel;         ///< Internal variables, their initial values and live values during a run
+    QTableView* internalsView;                  ///< Table of internal variables
 
-    QMap<QString, QLineEdit*> inputMap;         ///< Maps input names to their edit fields
+    VariableTableModel* inputsModel;            ///< Declared inputs and their last values
+    QTableView* inputsView;                     ///< Table of inputs
     QComboBox* inputComboBox = nullptr;         ///< Combo box for injecting inputs
     QLineEdit* inputValueEdit = nullptr;        ///< Field to input new value
     QPushButton* injectInputButton = nullptr;   ///< Button to inject input into FSM
 
-    QMap<QString, QLineEdit*> outputMap;        ///< Maps output names to display fields
-    QWidget* outputListContainer;               ///< Container for output value fields
-    QVBoxLayout* outputListLayout;              ///< Layout managing output rows
+    VariableTableModel* outputsModel;           ///< Declared outputs and their last values
+    QTableView* outputsView;                    ///< Table of outputs
 
-    QWidget* inputInjectionContainer = nullptr; ///< Container for input injection UI
-    QMap<QString, QLineEdit*> inputFieldMap;    ///< Maps inputs for runtime editing
-
-    QPlainTextEdit* logBox;                     ///< Debug log output field
+    QListView* logView;                         ///< Log output, lays out only the visible rows
+    LogModel* logModel;                         ///< Most recent LOG records, bounded
+    LogFilterModel* logFilter;                  ///< Element and variable filter over logModel
+    QLineEdit* logElementFilter;                ///< State name or transition id to show
+    QLineEdit* logVariableFilter;               ///< Variable whose changes are shown
 
     bool addingNewState = false;                ///< Whether the user is placing a new state
     QGraphicsEllipseItem* ghostCircle = nullptr;///< Temporary "ghost" preview circle
@@ -213,5 +222,84 @@ private:
     GuiController* controller = nullptr;        ///< Pointer to main controller class
     IActivable* lastActive = nullptr;           ///< Last highlighted item in scene
 
+    QHash<QString, StateItem*> stateItemIndex;      ///< State items by name, kept in sync with the scene
+    QHash<int, TransitionItem*> transitionItemIndex; ///< Confirmed transition items by id
+
     QString automatonName = "basic";
+
+    QWidget* replayBar = nullptr;               ///< Timeline shown while replaying a journal
+    QSlider* replaySlider = nullptr;            ///< Timeline position relative to replayStartMs
+    QLabel* replayLabel = nullptr;              ///< Time and element of the shown record
+    QTimer* replayTimer = nullptr;              ///< Coalesces slider moves into one seek per frame
+    std::unique_ptr<JournalReader> replayReader; ///< Journal being replayed, null when not replaying
+    int64_t replayStartMs = 0;                  ///< Timestamp of the first record
+    int64_t replayStepMs = 1;                   ///< Milliseconds per slider step
+    uint64_t replayShownSeq = UINT64_MAX;       ///< Sequence number of the shown record
+
+    LayoutWorker layoutWorker;                  ///< Lays out loaded automata in the background
+
+    /**
+     * @struct PendingItem
+     * @brief A state or transition waiting to be added to the scene while loading.
+     */
+    struct PendingItem {
+        qreal distance;                             ///< Distance from the visible center, smaller goes first
+        std::shared_ptr<State> state;               ///< State to add, null for a transition
+        std::shared_ptr<Transition> transition;     ///< Transition to add, null for a state
+        QPointF pos;                                ///< Position of a state
+    };
+
+    static constexpr qint64 LoadSliceMs = 8;    ///< Time spent adding items per event loop pass
+    std::thread loadThread;                     ///< Reads and parses the file being loaded
+    uint64_t loadGeneration = 0;                ///< Bumped by every load or clear, stale results are dropped
+    QTimer* loadTimer = nullptr;                ///< Adds the next slice of items to the scene
+    QProgressBar* loadProgress = nullptr;       ///< Progress of filling the scene
+    std::vector<PendingItem> loadQueue;         ///< Items of the loaded FSM, nearest first
+    size_t loadNext = 0;                        ///< Next item of loadQueue to add
+    QPointF loadCenter;                         ///< Scene point the loaded graph is centered on
+
+    /**
+     * @brief Takes over the FSM parsed by the load thread and starts filling the scene.
+     * @param generation Load generation the result belongs to.
+     * @param loaded The parsed FSM, null on error.
+     * @param model Editor copies of the states with their transitions.
+     * @param errorTitle Title of the error dialog.
+     * @param error Error shown when loaded is null.
+     */
+    void onFsmParsed(uint64_t generation, FSM* loaded, std::shared_ptr<StateTable> model,
+                     const QString& errorTitle, const QString& error);
+
+    /**
+     * @brief Adds queued items to the scene for one time slice, finishes the load after the last.
+     */
+    void loadNextBatch();
+
+    /**
+     * @brief Stops filling the scene and drops results of loads still being parsed.
+     */
+    void cancelLoading();
+
+    /**
+     * @brief Starts the automatic layout of the loaded FSM on the layout worker.
+     * @param center Scene point the finished layout is centered on.
+     */
+    void startAutoLayout(QPointF center);
+
+    /**
+     * @brief Moves the state items to a finished layout and reroutes their transitions.
+     * @param generation Generation of the layout, stale results are dropped.
+     * @param names State names in the order of the positions.
+     * @param positions Layout positions centered at the origin.
+     * @param center Scene point the layout is centered on.
+     */
+    void applyLayout(uint64_t generation, const std::vector<QString>& names,
+                     const std::vector<LayoutPoint>& positions, QPointF center);
+
+    /**
+     * @brief Creates a table view over a variable model, clicking ✕ removes the variable.
+     * @param model Model shown by the view.
+     * @param height Fixed height of the view.
+     * @return The view, owned by the window.
+     */
+    QTableView* createVariableView(VariableTableModel* model, int height);
 };
@@ -1,31 +1,37 @@
 #include "StateItem.h"
 #include <QInputDialog>
-#include <QPen>
-#include <QBrush>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QFontMetricsF>
 #include <QColor>
 #include <QMessageBox>
 
 constexpr int CircleDiameter = 80;
 constexpr int CircleRadius = CircleDiameter / 2;
+constexpr qreal LabelMargin = 4.0;     // same padding QGraphicsTextItem used
+constexpr qreal MaxPenWidth = 4.0;     // highlighted pen while hovered
 
-StateItem::StateItem(const QPointF& position, const QString& name) : initial(false) {
-    circle = new QGraphicsEllipseItem(-CircleRadius, -CircleRadius,
-                                      CircleDiameter, CircleDiameter, this);
-    circle->setPen(QPen(Qt::black, 2));
-    circle->setBrush(QBrush(Qt::NoBrush));
-    circle->setBrush(QBrush(Qt::white));
+StateItem::StateItem(const QPointF& position, const QString& name)
+    : name(name), pen(Qt::black, 2), brush(Qt::white), initial(false) {
+    label.setText(name);
+    label.setTextFormat(Qt::PlainText);
+    label.setPerformanceHint(QStaticText::AggressiveCaching);
 
-    label = new QGraphicsTextItem(name, this);
-    label->setDefaultTextColor(Qt::black);
-    label->setPos(-label->boundingRect().width() / 2,
-                  -label->boundingRect().height() / 2);
+    QSizeF labelSize = label.size();
+    labelPos = QPointF(-labelSize.width() / 2, -labelSize.height() / 2);
 
+    QRectF circleRect(-CircleRadius, -CircleRadius, CircleDiameter, CircleDiameter);
+    QRectF labelRect(labelPos, labelSize);
+    bounds = circleRect.united(labelRect.adjusted(-LabelMargin, -LabelMargin, LabelMargin, LabelMargin))
+                 .adjusted(-MaxPenWidth / 2, -MaxPenWidth / 2, MaxPenWidth / 2, MaxPenWidth / 2);
+
+    // Panning reuses the pixmap, it is only re-rendered on zoom or when the state changes
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
     setPos(position);
     setAcceptHoverEvents(true);    
 }
 
 void StateItem::updatePen() {
-    QPen pen;
     if (initial && final) {
         pen = QPen(Qt::green, 3);  // Both -> Green
     } else if (initial) {
@@ -35,7 +41,7 @@ void StateItem::updatePen() {
     } else {
         pen = QPen(Qt::black, 2);
     }
-    circle->setPen(pen);
+    update();
 }
 
 
@@ -59,47 +65,70 @@ bool StateItem::isFinal() const {
 }
 
 bool StateItem::containsScenePoint(const QPointF& pt) const {
-    // map the scene mouse-point into the group’s local coords
+    // map the scene mouse-point into local coords, the circle is centered at the origin
     QPointF local = mapFromScene(pt);
-    // use the ellipse’s contains() which tests its exact shape
-    return circle->contains(local);
+    return QPointF::dotProduct(local, local) <= CircleRadius * CircleRadius;
 }
 
 QString StateItem::getName() const {
-    return label->toPlainText();
+    return name;
 }
 
 void StateItem::hoverEnterEvent(QGraphicsSceneHoverEvent* event) {
-    QPen p = circle->pen();
-    p.setWidth(p.width() + 1);  // Just thicken, don’t change color
-    circle->setPen(p);
+    Q_UNUSED(event);
+    hovered = true;  // Just thicken, don’t change color
+    update();
 }
 
 void StateItem::hoverLeaveEvent(QGraphicsSceneHoverEvent* event) {
-    updatePen();  // Restore correct color and width
+    Q_UNUSED(event);
+    hovered = false;  // Restore correct color and width
+    update();
 }
 
 
 QPointF StateItem::sceneCenter() const {
-    return mapToScene(circle->rect().center());
+    return mapToScene(QPointF(0, 0));
 }
 
 QRectF StateItem::boundingRect() const {
-    return circle->boundingRect();  // or a fixed size if needed
+    return bounds;
+}
+
+QPainterPath StateItem::shape() const {
+    QPainterPath path;
+    path.addEllipse(QPointF(0, 0), CircleRadius, CircleRadius);
+    return path;
 }
 
-void StateItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
-    // No painting here since sub-items (circle, label) handle their own painting
-    Q_UNUSED(painter);
+void StateItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) {
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+
+    QPen outline = pen;
+    if (hovered)
+        outline.setWidthF(outline.widthF() + 1);
+
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    painter->setPen(outline);
+    painter->setBrush(brush);
+    painter->drawEllipse(QPointF(0, 0), CircleRadius, CircleRadius);
+
+    // Text too small to read only costs glyph rendering
+    if (lod < LabelDetailLevel)
+        return;
+
+    painter->setPen(Qt::black);
+    painter->drawStaticText(labelPos, label);
 }
 
 void StateItem::setActive(bool isNowActive) {
     active = isNowActive;
     if (active) {
-        circle->setBrush(QBrush(Qt::green));
+        brush = QBrush(Qt::green);
     } else {
-        circle->setBrush(QBrush(Qt::white));
+        brush = QBrush(Qt::white);
     }
+    update();
 }
 
 bool StateItem::isActive() const {
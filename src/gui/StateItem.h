@@ -15,6 +15,9 @@
 #include <QGraphicsEllipseItem>
 #include <QGraphicsTextItem>
 #include <QGraphicsSceneHoverEvent>
+#include <QStaticText>
+#include <QPen>
+#include <QBrush>
 #include "IActivable.h"
 
 /**
@@ -23,11 +26,15 @@
  *
  * This class manages the drawing and interaction logic of an FSM state circle,
  * including its name label, highlighting, and initial/final status.
+ * The circle and label are painted by the item itself into a device-coordinate
+ * pixmap cache, the label is skipped when zoomed out too far to read it.
  */
 class StateItem : public QGraphicsObject, public IActivable {
     Q_OBJECT
 
 public:
+    static constexpr qreal LabelDetailLevel = 0.4;  ///< Minimum zoom at which the name is drawn
+
     /**
      * @brief Constructs a new StateItem.
      * @param position The initial position of the state in the scene.
@@ -117,13 +124,27 @@ protected:
     QRectF boundingRect() const override;
 
     /**
-     * @brief Custom painting logic for the state. Unused since we rely on QGraphicsEllipseItem.
+     * @brief Returns the circle, used for hit testing in the scene.
+     * @return Shape of the state.
+     */
+    QPainterPath shape() const override;
+
+    /**
+     * @brief Paints the circle and, when zoomed in enough, the name.
+     * @param painter QPainter used to draw the state.
+     * @param option Style options, provide the level of detail.
+     * @param widget Unused. The widget being painted on.
      */
-    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
 
 private:
-    QGraphicsEllipseItem* circle;  ///< The circular shape representing the state.
-    QGraphicsTextItem* label;      ///< The text label displaying the state name.
+    QString name;                  ///< Name of the state.
+    QStaticText label;             ///< Laid out name, reused by every paint.
+    QPointF labelPos;              ///< Top-left corner of the label.
+    QRectF bounds;                 ///< Circle and label including the widest pen.
+    QPen pen;                      ///< Circle outline for the current status.
+    QBrush brush;                  ///< Circle fill, green while active.
+    bool hovered = false;          ///< True while the mouse is over the state.
     bool initial = false;          ///< True if this is the initial state.
     bool final = false;            ///< True if this is a final (accepting) state.
     bool active = false;           ///< True if this state is currently highlighted.
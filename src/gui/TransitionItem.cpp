@@ -10,9 +10,8 @@ TransitionItem::TransitionItem(QPointF start, QPointF end, QGraphicsItem* parent
     setPen(pen);
     setZValue(-1);
 
-    label = new QGraphicsTextItem(this);
-    label->setDefaultTextColor(Qt::darkBlue);
-    label->setZValue(1); // Draw above the line
+    label.setTextFormat(Qt::PlainText);
+    label.setPerformanceHint(QStaticText::AggressiveCaching);
 
     updateLine(start, end);
 }
@@ -21,11 +20,12 @@ int TransitionItem::getId() const {
     return this->id;
 }
 
-void TransitionItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*)
+void TransitionItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
 {
     constexpr qreal PEN_ACTIVE_W   = 3.0;
     constexpr qreal PEN_IDLE_W     = 2.0;
-    constexpr qreal ARROW_LEN      = 12.0; 
+
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     painter->setRenderHint(QPainter::Antialiasing, true);
     painter->setPen(QPen(active ? Qt::red : Qt::black,
@@ -36,39 +36,83 @@ void TransitionItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, Q
     painter->setBrush(Qt::NoBrush);
     painter->drawPath(path());                 // the path was built in updateLine()
 
-    if (!confirmed)
-        return;
+    if (confirmed && lod >= ArrowDetailLevel) {
+        painter->setBrush(Qt::black);
+        painter->drawPolygon(arrowHead);       // the arrowhead was built in updateLine()
+    }
+
+    if (lod >= LabelDetailLevel && !labelString.isEmpty()) {
+        painter->setPen(Qt::darkBlue);
+        painter->drawStaticText(labelPos, label);
+    }
+}
+
+QRectF TransitionItem::boundingRect() const {
+    return bounds;
+}
+
+
+void TransitionItem::setLabel(const QString& text) {
+    prepareGeometryChange();
+    labelString = text;
+    label.setText(text);
+    updateLabelPosition();
+    updateBounds();
+    update();
+}
+
+void TransitionItem::markConfirmed() {
+    prepareGeometryChange();
+    confirmed = true;
+    updateArrowHead();
+    updateBounds();
+    update();
+}
+
+void TransitionItem::updateLabelPosition() {
+    QPointF center = path().pointAtPercent(0.5);
+    QPointF direction = path().pointAtPercent(0.55) - path().pointAtPercent(0.45);
+    QPointF normal(-direction.y(), direction.x());
+
+    qreal length = std::hypot(normal.x(), normal.y());
+    if (length > 0.0)
+        normal /= length;
+
+    QPointF finalPos = center + normal * 25.0;
 
+    QSizeF labelSize = label.size();
+    labelPos = finalPos - QPointF(labelSize.width() / 2, labelSize.height() / 2);
+}
+
+void TransitionItem::updateArrowHead() {
+    constexpr qreal ARROW_LEN = 12.0;
+
+    const QPainterPath& curve = path();
     const bool selfLoop = (start == end);
 
     QPointF tip, back;
 
     if (selfLoop) {
-        tip  = path().pointAtPercent(0.12);
-        back = path().pointAtPercent(0.18);
+        tip  = curve.pointAtPercent(0.12);
+        back = curve.pointAtPercent(0.18);
     } else {
         constexpr qreal STATE_R   = 40.0;        
         constexpr qreal GAP_AHEAD = STATE_R + ARROW_LEN + 2.0;   // +2 px safety
 
         qreal tTip = 1.0;
         for (qreal t = 1.0; t >= 0.0; t -= 0.01) {        // fine-grained search
-            if (QLineF(path().pointAtPercent(t), end).length() >= GAP_AHEAD) {
+            if (QLineF(curve.pointAtPercent(t), end).length() >= GAP_AHEAD) {
                 tTip = t;
                 break;
             }
         }
-        tip  = path().pointAtPercent(tTip);
-        back = path().pointAtPercent(std::max(0.0, tTip - 0.03));  
         constexpr qreal SHIFT = 0.06;
         const qreal tTipShift = std::min(0.99, tTip + SHIFT);
 
-        tip  = path().pointAtPercent(tTipShift);
-        back = path().pointAtPercent(std::max(0.0, tTipShift - 0.03));
-
+        tip  = curve.pointAtPercent(tTipShift);
+        back = curve.pointAtPercent(std::max(0.0, tTipShift - 0.03));
     }
 
-    painter->drawPath(path());
-
     const QPointF dir   = tip - back;
 
     // angle of the tangent in the direction tip destination
@@ -80,33 +124,18 @@ void TransitionItem::paint(QPainter* painter, const QStyleOptionGraphicsItem*, Q
     const QPointF p2 = tip - QPointF(std::cos(angle + ARROW_HALF_ANG) * ARROW_LEN,
                                     std::sin(angle + ARROW_HALF_ANG) * ARROW_LEN);
 
-    painter->setBrush(Qt::black);
-    painter->drawPolygon(QPolygonF() << tip << p1 << p2);
-}
-
-
-void TransitionItem::setLabel(const QString& text) {
-    label->setPlainText(text);
-    updateLabelPosition();
-}
-
-void TransitionItem::markConfirmed() {
-    confirmed = true;
-    update();
+    arrowHead = QPolygonF() << tip << p1 << p2;
 }
 
-void TransitionItem::updateLabelPosition() {
-    QPointF center = path().pointAtPercent(0.5);
-    QPointF direction = path().pointAtPercent(0.55) - path().pointAtPercent(0.45);
-    QPointF normal(-direction.y(), direction.x());
-
-    qreal length = std::hypot(normal.x(), normal.y());
-    if (length > 0.0)
-        normal /= length;
-
-    QPointF finalPos = center + normal * 25.0;
+void TransitionItem::updateBounds() {
+    constexpr qreal HALF_PEN = 2.0;   // widest (active) pen is 3 px, rounded up
 
-    label->setPos(finalPos - QPointF(label->boundingRect().width() / 2, label->boundingRect().height() / 2));
+    QRectF rect = path().controlPointRect();
+    if (confirmed)
+        rect = rect.united(arrowHead.boundingRect());
+    if (!labelString.isEmpty())
+        rect = rect.united(QRectF(labelPos, label.size()));
+    bounds = rect.adjusted(-HALF_PEN, -HALF_PEN, HALF_PEN, HALF_PEN);
 }
 
 
@@ -155,6 +184,9 @@ void TransitionItem::updateLine(QPointF s, QPointF e)
 
     setPath(p);
     updateLabelPosition();            
+    if (confirmed)
+        updateArrowHead();
+    updateBounds();
     update();
 }
 
@@ -170,5 +202,5 @@ bool TransitionItem::isActive() const {
 }
 
 QString TransitionItem::labelText() const {
-    return label->toPlainText();
+    return labelString;
 }
@@ -17,6 +17,8 @@
 #include <QGraphicsPathItem>
 #include <QGraphicsTextItem>
 #include <QPen>
+#include <QPolygonF>
+#include <QStaticText>
 #include "IActivable.h"
 
 /**
@@ -24,10 +26,15 @@
  * @brief Represents a graphical transition between two FSM states.
  * 
  * Draws a curved line or self-loop, displays a label, and supports runtime highlighting.
- * Used inside the FSMCraft scene to connect StateItems visually.
+ * Used inside the FSMCraft scene to connect StateItems visually. The curve, arrowhead and
+ * label position are computed once in updateLine(), paint() only draws them and leaves out
+ * the arrowhead and label when zoomed out.
  */
 class TransitionItem : public QGraphicsPathItem, public IActivable {
 public:
+    static constexpr qreal ArrowDetailLevel = 0.3;  ///< Minimum zoom at which the arrowhead is drawn
+    static constexpr qreal LabelDetailLevel = 0.6;  ///< Minimum zoom at which the label is drawn
+
     /**
      * @brief Constructs a transition between two points.
      * @param start Starting point of the transition.
@@ -45,6 +52,12 @@ public:
      */
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
 
+    /**
+     * @brief Returns the area covered by the curve, arrowhead and label.
+     * @return Cached bounding rectangle.
+     */
+    QRectF boundingRect() const override;
+
     /**
      * @brief Updates the visual curve between the two endpoints.
      * @param start New starting point.
@@ -88,15 +101,29 @@ public:
     int getId() const;
 
 private:
-    QGraphicsTextItem* label = nullptr; ///< Text label for input/condition
+    QString labelString;                ///< Text label for input/condition
+    QStaticText label;                  ///< Laid out label, reused by every paint
+    QPointF labelPos;                   ///< Top-left corner of the label
+    QPolygonF arrowHead;                ///< Arrowhead at the target end of the curve
+    QRectF bounds;                      ///< Curve, arrowhead and label including the pen
     bool active = false;                ///< Whether the transition is visually active
     bool confirmed = false;             ///< Whether the transition has been finalized
+    int id;                             ///< Identifier for backend matching
     QPointF start;                      ///< Starting point of the curve
     QPointF end;                        ///< Ending point of the curve
-    int id;                             ///< Identifier for backend matching
 
     /**
      * @brief Repositions the label according to the current curve.
      */
     void updateLabelPosition();
+
+    /**
+     * @brief Computes the arrowhead polygon for the current curve.
+     */
+    void updateArrowHead();
+
+    /**
+     * @brief Recomputes the bounding rectangle after the curve or label changed.
+     */
+    void updateBounds();
 };
@@ -0,0 +1,175 @@
+/**
+ * @file VariableTableModel.cpp
+ * @brief Implementation of the table model of declared inputs, outputs or internal variables.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "VariableTableModel.h"
+#include <algorithm>
+#include <climits>
+
+VariableTableModel::VariableTableModel(bool editableValues, QObject* parent)
+    : QAbstractTableModel(parent), editableValues(editableValues) {}
+
+int VariableTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rows.size());
+}
+
+int VariableTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant VariableTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(rows.size()))
+        return QVariant();
+
+    const Row& row = rows[static_cast<size_t>(index.row())];
+    if (role == Qt::DisplayRole || role == Qt::EditRole) {
+        switch (index.column()) {
+            case NameColumn: return row.name;
+            case ValueColumn: return role == Qt::DisplayRole ? row.shown() : row.value;
+            case RemoveColumn: return role == Qt::DisplayRole ? QString("✕") : QVariant();
+            default: return QVariant();
+        }
+    }
+    if (role == Qt::ToolTipRole && index.column() == RemoveColumn)
+        return QString("Remove " + row.name);
+    if (role == Qt::TextAlignmentRole && index.column() == RemoveColumn)
+        return Qt::AlignCenter;
+    return QVariant();
+}
+
+bool VariableTableModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (role != Qt::EditRole || !index.isValid() || index.column() != ValueColumn || !editableValues)
+        return false;
+
+    rows[static_cast<size_t>(index.row())].value = value.toString().trimmed();
+    emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+    return true;
+}
+
+QVariant VariableTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QVariant();
+
+    switch (section) {
+        case NameColumn: return QString("Name");
+        case ValueColumn: return QString("Value");
+        default: return QString();
+    }
+}
+
+Qt::ItemFlags VariableTableModel::flags(const QModelIndex& index) const {
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+    if (editableValues && index.column() == ValueColumn)
+        result |= Qt::ItemIsEditable;
+    return result;
+}
+
+bool VariableTableModel::addVariable(const QString& name, const QString& value) {
+    if (rowOf.contains(name))
+        return false;
+
+    int row = static_cast<int>(rows.size());
+    beginInsertRows(QModelIndex(), row, row);
+    rows.push_back({name, value, QString(), false});
+    rowOf.insert(name, row);
+    endInsertRows();
+    return true;
+}
+
+bool VariableTableModel::removeVariable(const QString& name) {
+    auto it = rowOf.find(name);
+    if (it == rowOf.end())
+        return false;
+
+    int row = it.value();
+    beginRemoveRows(QModelIndex(), row, row);
+    rows.erase(rows.begin() + row);
+    rowOf.erase(it);
+    for (int i = row; i < static_cast<int>(rows.size()); ++i)
+        rowOf[rows[static_cast<size_t>(i)].name] = i;
+    endRemoveRows();
+    return true;
+}
+
+void VariableTableModel::clear() {
+    beginResetModel();
+    rows.clear();
+    rowOf.clear();
+    endResetModel();
+}
+
+bool VariableTableModel::contains(const QString& name) const {
+    return rowOf.contains(name);
+}
+
+QString VariableTableModel::value(const QString& name) const {
+    auto it = rowOf.find(name);
+    return it == rowOf.end() ? QString() : rows[static_cast<size_t>(it.value())].value;
+}
+
+QString VariableTableModel::nameAt(int row) const {
+    return rows[static_cast<size_t>(row)].name;
+}
+
+QStringList VariableTableModel::names() const {
+    QStringList result;
+    result.reserve(static_cast<int>(rows.size()));
+    for (const Row& row : rows)
+        result << row.name;
+    return result;
+}
+
+void VariableTableModel::setValue(const QString& name, const QString& value) {
+    auto it = rowOf.find(name);
+    if (it == rowOf.end())
+        return;
+
+    Row& row = rows[static_cast<size_t>(it.value())];
+    if (row.value == value && !row.hasLive)
+        return;
+    row.value = value;
+    row.hasLive = false;
+    QModelIndex changed = index(it.value(), ValueColumn);
+    emit dataChanged(changed, changed, {Qt::DisplayRole});
+}
+
+void VariableTableModel::setValues(const std::map<std::string, std::string>& values) {
+    int first = INT_MAX;
+    int last = -1;
+    for (const auto& [name, value] : values) {
+        auto it = rowOf.find(QString::fromStdString(name));
+        if (it == rowOf.end())
+            continue;
+
+        QString text = QString::fromStdString(value);
+        Row& row = rows[static_cast<size_t>(it.value())];
+        if (row.hasLive && row.live == text)
+            continue;
+        row.live = text;
+        row.hasLive = true;
+        first = std::min(first, it.value());
+        last = std::max(last, it.value());
+    }
+
+    // One notification for the span of changed rows, the view repaints only what is visible in it
+    if (last >= 0)
+        emit dataChanged(index(first, ValueColumn), index(last, ValueColumn), {Qt::DisplayRole});
+}
+
+void VariableTableModel::clearLiveValues() {
+    int first = INT_MAX;
+    int last = -1;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (!rows[i].hasLive)
+            continue;
+        rows[i].hasLive = false;
+        rows[i].live.clear();
+        first = std::min(first, static_cast<int>(i));
+        last = std::max(last, static_cast<int>(i));
+    }
+    if (last >= 0)
+        emit dataChanged(index(first, ValueColumn), index(last, ValueColumn), {Qt::DisplayRole});
+}
@@ -0,0 +1,183 @@
+/**
+ * @file VariableTableModel.h
+ * @brief Header file for the table model of declared inputs, outputs or internal variables.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Names and current values of one group of variables.
+ *
+ * Replaces one row of widgets per variable: the view draws only the visible rows and
+ * creates an editor only for the cell being edited. Values from a LOG message are applied
+ * in bulk with a single dataChanged() for the rows that actually changed.
+ *
+ * Values from LOG messages are live values kept apart from the declared ones: the view
+ * shows a live value while there is one, value() and editing always use the declared value.
+ */
+class VariableTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Columns of the table.
+     */
+    enum Column {
+        NameColumn = 0,     ///< Variable name
+        ValueColumn,        ///< Current value
+        RemoveColumn,       ///< Remove marker, clicking it removes the variable
+        ColumnCount
+    };
+
+    /**
+     * @brief Constructor for the variable model.
+     * @param editableValues Whether values can be edited in the view (initial values of internals).
+     * @param parent Optional parent object.
+     */
+    explicit VariableTableModel(bool editableValues = false, QObject* parent = nullptr);
+
+    /**
+     * @brief Number of variables.
+     * @param parent Unused, the model is a flat table.
+     * @return Row count.
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Number of columns.
+     * @param parent Unused, the model is a flat table.
+     * @return ColumnCount.
+     */
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Provides the name, value and remove marker of a variable.
+     * @param index Cell of the table.
+     * @param role Qt::DisplayRole, Qt::EditRole or Qt::ToolTipRole.
+     * @return The requested data.
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Stores a value edited in the view.
+     * @param index Cell of the value.
+     * @param value The new value.
+     * @param role Qt::EditRole.
+     * @return True if the value was stored.
+     */
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    /**
+     * @brief Column titles.
+     * @param section Column or row number.
+     * @param orientation Header orientation.
+     * @param role Qt::DisplayRole.
+     * @return The title.
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Marks the value cells as editable when enabled.
+     * @param index Cell of the table.
+     * @return Item flags.
+     */
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    /**
+     * @brief Appends a variable.
+     * @param name Name of the variable.
+     * @param value Initial value.
+     * @return False if a variable of that name exists.
+     */
+    bool addVariable(const QString& name, const QString& value);
+
+    /**
+     * @brief Removes a variable.
+     * @param name Name of the variable.
+     * @return False if there is no such variable.
+     */
+    bool removeVariable(const QString& name);
+
+    /**
+     * @brief Removes all variables.
+     */
+    void clear();
+
+    /**
+     * @brief Checks whether a variable exists.
+     * @param name Name of the variable.
+     * @return True if it exists.
+     */
+    bool contains(const QString& name) const;
+
+    /**
+     * @brief Gets the declared value of a variable, never a live value.
+     * @param name Name of the variable.
+     * @return The value, empty if there is no such variable.
+     */
+    QString value(const QString& name) const;
+
+    /**
+     * @brief Gets the name of the variable on a row.
+     * @param row Row of the variable.
+     * @return The name.
+     */
+    QString nameAt(int row) const;
+
+    /**
+     * @brief Gets the names of all variables in row order.
+     * @return The names.
+     */
+    QStringList names() const;
+
+    /**
+     * @brief Sets the declared value of one variable, dropping its live value.
+     * @param name Name of the variable.
+     * @param value The new value.
+     */
+    void setValue(const QString& name, const QString& value);
+
+    /**
+     * @brief Applies the values of a LOG message as live values, unknown names are ignored.
+     * @param values Names and values.
+     */
+    void setValues(const std::map<std::string, std::string>& values);
+
+    /**
+     * @brief Drops the live values, the view shows the declared values again.
+     */
+    void clearLiveValues();
+
+private:
+    /**
+     * @brief One variable of the table.
+     */
+    struct Row {
+        QString name;           ///< Variable name
+        QString value;          ///< Declared value, saved with the FSM
+        QString live;           ///< Value reported by the last LOG message
+        bool hasLive = false;   ///< Whether live holds a value
+
+        /**
+         * @brief Gets the value shown in the view.
+         * @return The live value if any, the declared value otherwise.
+         */
+        const QString& shown() const {
+            return hasLive ? live : value;
+        }
+    };
+
+    std::vector<Row> rows;          ///< Variables in the order they were added
+    QHash<QString, int> rowOf;      ///< Row of every variable
+    bool editableValues;            ///< Whether values can be edited in the view
+};
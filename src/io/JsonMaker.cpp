@@ -41,10 +41,10 @@ QJsonObject JsonMaker::toJson(FSM* fsm) {
     QJsonArray statesArr;
     for (auto& state : fsm->getStates()) {
       QJsonObject stateObj;
-      stateObj["name"] = QString::fromStdString(state.first);
-      stateObj["action"] = QString::fromStdString(state.second->getActionCode());
-      stateObj["isInitial"] = state.second->isInitialState();
-      stateObj["isFinal"] = state.second->isFinalState();
+      stateObj["name"] = QString::fromStdString(state->getName());
+      stateObj["action"] = QString::fromStdString(state->getActionCode());
+      stateObj["isInitial"] = state->isInitialState();
+      stateObj["isFinal"] = state->isFinalState();
       statesArr.append(stateObj);
     }
     doc["states"] = statesArr;
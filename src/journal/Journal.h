@@ -0,0 +1,319 @@
+/**
+ * @file Journal.h
+ * @brief Header file for the append-only binary journal of LOG events.
+ *
+ * The journal is a directory of segments. Each segment "journal-<first seq>.fjl" holds
+ * length-prefixed, checksummed records; every segment starts with a keyframe carrying the
+ * full variable state, later records are deltas with the changed variables only, and a new
+ * keyframe is written every keyframeInterval records. The sidecar "journal-<first seq>.idx"
+ * lists the sequence number, timestamp and file offset of every keyframe, so a time-range
+ * query binary searches the index and decodes at most one keyframe interval it does not need.
+ *
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/EItemType.h"
+
+/**
+ * @struct JournalRecord
+ * @brief One LOG event with the full variable state after it.
+ */
+struct JournalRecord {
+    uint64_t seq = 0;                                   /**< Sequence number within the journal. */
+    int64_t timestampMs = 0;                            /**< Milliseconds since the epoch. */
+    bool keyframe = false;                              /**< Whether the record was stored as a keyframe. */
+    EItemType elementType = EItemType::STATE;           /**< Type of the entered or taken element. */
+    std::string currentElement;                         /**< Name of the state or id of the transition. */
+    std::map<std::string, std::string> inputValues;     /**< Input values. */
+    std::map<std::string, std::string> outputValues;    /**< Output values. */
+    std::map<std::string, std::string> internalValues;  /**< Internal variable values. */
+};
+
+/**
+ * @struct JournalIndexEntry
+ * @brief Position of a keyframe inside a segment.
+ */
+struct JournalIndexEntry {
+    uint64_t seq;           /**< Sequence number of the keyframe. */
+    int64_t timestampMs;    /**< Timestamp of the keyframe. */
+    uint64_t offset;        /**< Byte offset of the record in the segment. */
+};
+
+/** @brief Magic number at the start of every segment ("FSMJ"). */
+constexpr uint32_t JournalSegmentMagic = 0x4a4d5346;
+
+/** @brief Magic number at the start of every index ("FSMI"). */
+constexpr uint32_t JournalIndexMagic = 0x494d5346;
+
+/** @brief Version of the segment and index layout. */
+constexpr uint32_t JournalVersion = 1;
+
+/** @brief Size of the file header of segments and indexes (magic and version). */
+constexpr size_t JournalFileHeaderSize = 8;
+
+/** @brief Size of the record header (payload length and checksum). */
+constexpr size_t JournalRecordHeaderSize = 8;
+
+/**
+ * @brief Builds the file name of a segment or index.
+ * @param firstSeq Sequence number of the first record of the segment.
+ * @param extension File extension, ".fjl" or ".idx".
+ * @return The file name without directory.
+ */
+std::string journalFileName(uint64_t firstSeq, const std::string& extension);
+
+/**
+ * @brief Appends the encoded record (header and payload) to the buffer.
+ * @param buffer Buffer to append to.
+ * @param record The record, only changed variables are expected in deltas.
+ */
+void encodeJournalRecord(std::string& buffer, const JournalRecord& record);
+
+/**
+ * @brief Decodes a record payload.
+ * @param data Payload bytes.
+ * @param size Payload size.
+ * @param record Receives the record, variable maps hold what was stored (full or delta).
+ * @return False if the payload is malformed.
+ */
+bool decodeJournalRecord(const char* data, size_t size, JournalRecord& record);
+
+/**
+ * @brief Computes the checksum protecting a record payload (CRC-32).
+ * @param data Payload bytes.
+ * @param size Payload size.
+ * @return The checksum.
+ */
+uint32_t journalChecksum(const char* data, size_t size);
+
+/**
+ * @class JournalWriter
+ * @brief Appends LOG events to the journal, called from the interpreter thread.
+ *
+ * Records are encoded into a memory buffer. A background thread writes the buffer out and
+ * fsyncs it every syncIntervalMs, so the interpreter never waits for the disk unless the
+ * buffer grows past its limit.
+ */
+class JournalWriter {
+public:
+    static constexpr uint64_t DefaultSegmentBytes = 64ull * 1024 * 1024;   ///< Segment size before rolling over.
+    static constexpr uint32_t DefaultKeyframeInterval = 256;               ///< Records between keyframes.
+    static constexpr int DefaultSyncIntervalMs = 1000;                     ///< Period of the background fsync.
+    static constexpr size_t BufferLimit = 1024 * 1024;                     ///< Buffered bytes forcing a write.
+
+    /**
+     * @brief Opens the journal directory and starts a new segment.
+     * @param directory Directory of the journal, created when missing.
+     * @param segmentBytes Size after which a new segment is started.
+     * @param keyframeInterval Number of records between keyframes.
+     * @param syncIntervalMs Period of the background flush and fsync.
+     */
+    JournalWriter(const std::string& directory,
+                  uint64_t segmentBytes = DefaultSegmentBytes,
+                  uint32_t keyframeInterval = DefaultKeyframeInterval,
+                  int syncIntervalMs = DefaultSyncIntervalMs);
+
+    /**
+     * @brief Writes and syncs the remaining records and closes the segment.
+     */
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    /**
+     * @brief Checks whether the journal was opened successfully.
+     * @return True if records are persisted.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Appends a LOG event.
+     * @param timestampMs Milliseconds since the epoch.
+     * @param elementType Type of the entered or taken element.
+     * @param currentElement Name of the state or id of the transition.
+     * @param inputValues Current input values.
+     * @param outputValues Current output values.
+     * @param internalValues Current internal variable values.
+     */
+    void append(int64_t timestampMs,
+                EItemType elementType,
+                const std::string& currentElement,
+                const std::map<std::string, std::string>& inputValues,
+                const std::map<std::string, std::string>& outputValues,
+                const std::map<std::string, std::string>& internalValues);
+
+    /**
+     * @brief Writes buffered records to the segment.
+     * @param sync Also fsync the segment and its index.
+     */
+    void flush(bool sync);
+
+    /**
+     * @brief Reads the journal directory from the FSMCRAFT_JOURNAL_DIR environment variable.
+     * @return The directory, empty when journaling is disabled.
+     */
+    static std::string directoryFromEnvironment();
+
+private:
+    /**
+     * @brief Starts a new segment whose first record gets the given sequence number.
+     * @param firstSeq Sequence number of the first record.
+     * @return True on success.
+     */
+    bool openSegment(uint64_t firstSeq);
+
+    /**
+     * @brief Writes the buffers out and closes the current segment, expects writerMutex held.
+     */
+    void closeSegment();
+
+    /**
+     * @brief Writes the buffers to the files, expects writerMutex held.
+     * @param sync Also fsync both files.
+     */
+    void writeBuffers(bool sync);
+
+    /**
+     * @brief Writes the data to the files, expects ioMutex held.
+     * @param segmentFd Segment descriptor.
+     * @param indexFd Index descriptor.
+     * @param segmentData Encoded records.
+     * @param indexData Index entries.
+     * @param sync Also fsync both files.
+     */
+    static void writeOut(int segmentFd, int indexFd,
+                         const std::string& segmentData, const std::string& indexData, bool sync);
+
+    /**
+     * @brief Periodically flushes and syncs until the writer is destroyed.
+     */
+    void syncLoop();
+
+    std::string directory;                                  /**< Journal directory. */
+    uint64_t segmentBytes;                                  /**< Rollover size. */
+    uint32_t keyframeInterval;                              /**< Records between keyframes. */
+    int syncIntervalMs;                                     /**< Flush period. */
+
+    std::mutex writerMutex;                                 /**< Guards everything below. */
+    std::mutex ioMutex;                                     /**< Held while writing to the files, taken after writerMutex. */
+    std::condition_variable stopSignal;                     /**< Wakes the sync thread on destruction. */
+    bool stopping = false;                                  /**< Set when the writer is destroyed. */
+    std::thread syncThread;                                 /**< Background flush thread. */
+
+    int segmentFd = -1;                                     /**< Current segment. */
+    int indexFd = -1;                                       /**< Index of the current segment. */
+    uint64_t segmentSize = 0;                               /**< Bytes of the segment including buffered ones. */
+    std::string segmentBuffer;                              /**< Encoded records not yet written. */
+    std::string indexBuffer;                                /**< Index entries not yet written. */
+    uint64_t nextSeq = 0;                                   /**< Sequence number of the next record. */
+    uint32_t sinceKeyframe = 0;                             /**< Records since the last keyframe. */
+    std::map<std::string, std::string> lastInputs;          /**< State after the last record. */
+    std::map<std::string, std::string> lastOutputs;         /**< State after the last record. */
+    std::map<std::string, std::string> lastInternals;       /**< State after the last record. */
+};
+
+/**
+ * @class JournalReader
+ * @brief Answers time-range and point-in-time queries over a journal directory.
+ */
+class JournalReader {
+public:
+    /**
+     * @brief Creates a reader of the directory, call open() before querying.
+     * @param directory Directory of the journal.
+     */
+    explicit JournalReader(const std::string& directory);
+
+    /**
+     * @brief Lists the segments and loads their indexes.
+     * @return False if the directory holds no segments.
+     */
+    bool open();
+
+    /**
+     * @brief Calls the visitor for every record with timestamp in [fromMs, toMs], in order.
+     * @param fromMs Start of the range.
+     * @param toMs End of the range.
+     * @param visitor Receives records with the full state, returns false to stop.
+     */
+    void forEachInRange(int64_t fromMs, int64_t toMs,
+                        const std::function<bool(const JournalRecord&)>& visitor) const;
+
+    /**
+     * @brief Collects the records with timestamp in [fromMs, toMs].
+     * @param fromMs Start of the range.
+     * @param toMs End of the range.
+     * @return The records with the full state.
+     */
+    std::vector<JournalRecord> query(int64_t fromMs, int64_t toMs) const;
+
+    /**
+     * @brief Reconstructs the last record at or before the timestamp.
+     *
+     * Starts at the nearest preceding keyframe and applies at most one keyframe interval of deltas.
+     *
+     * @param timestampMs The point in time.
+     * @param record Receives the record with the full state.
+     * @return False if the journal has no record that early.
+     */
+    bool stateAt(int64_t timestampMs, JournalRecord& record) const;
+
+    /**
+     * @brief Gets the timestamps of the first and the last record.
+     * @param firstMs Receives the first timestamp.
+     * @param lastMs Receives the last timestamp.
+     * @return False if the journal is empty.
+     */
+    bool timeBounds(int64_t& firstMs, int64_t& lastMs) const;
+
+    /**
+     * @brief Reads the last complete record of the journal.
+     * @param record Receives the record with the full state.
+     * @return False if the journal is empty.
+     */
+    bool lastRecord(JournalRecord& record) const;
+
+private:
+    /**
+     * @struct Segment
+     * @brief A segment file with its loaded index.
+     */
+    struct Segment {
+        std::string path;                       /**< Path of the segment. */
+        uint64_t firstSeq;                      /**< Sequence number of its first record. */
+        std::vector<JournalIndexEntry> index;   /**< Keyframes of the segment. */
+    };
+
+    /**
+     * @brief Decodes the records of a segment from the last keyframe before the timestamp.
+     * @param segment The segment to read.
+     * @param timestampMs Timestamp to start near.
+     * @param inclusive Whether a keyframe stamped exactly timestampMs may be the start.
+     * @param visitor Receives every decoded record with full state, returns false to stop.
+     */
+    void scanSegment(const Segment& segment, int64_t timestampMs, bool inclusive,
+                     const std::function<bool(const JournalRecord&)>& visitor) const;
+
+    /**
+     * @brief Finds the last segment starting before the timestamp.
+     * @param timestampMs The timestamp.
+     * @param inclusive Whether a segment starting exactly at timestampMs qualifies.
+     * @return Index into segments.
+     */
+    size_t segmentFor(int64_t timestampMs, bool inclusive) const;
+
+    std::string directory;              /**< Journal directory. */
+    std::vector<Segment> segments;      /**< Segments ordered by first sequence number. */
+};
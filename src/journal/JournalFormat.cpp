@@ -0,0 +1,168 @@
+/**
+ * @file JournalFormat.cpp
+ * @brief Encoding of journal records shared by the writer and the reader.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "Journal.h"
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Builds the CRC-32 lookup table.
+ * @return The table for the reflected polynomial 0xEDB88320.
+ */
+static std::array<uint32_t, 256> makeChecksumTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+uint32_t journalChecksum(const char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = makeChecksumTable();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+std::string journalFileName(uint64_t firstSeq, const std::string& extension) {
+    char name[48];
+    std::snprintf(name, sizeof(name), "journal-%020llu", static_cast<unsigned long long>(firstSeq));
+    return name + extension;
+}
+
+/**
+ * @brief Appends a fixed-size value in host byte order.
+ * @param buffer Buffer to append to.
+ * @param value Value to append.
+ */
+template <typename T>
+static void put(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Appends a length-prefixed string.
+ * @param buffer Buffer to append to.
+ * @param str String to append.
+ */
+static void putString(std::string& buffer, const std::string& str) {
+    put<uint32_t>(buffer, static_cast<uint32_t>(str.size()));
+    buffer.append(str);
+}
+
+/**
+ * @brief Appends a map as a count followed by key and value strings.
+ * @param buffer Buffer to append to.
+ * @param values Map to append.
+ */
+static void putMap(std::string& buffer, const std::map<std::string, std::string>& values) {
+    put<uint32_t>(buffer, static_cast<uint32_t>(values.size()));
+    for (const auto& [key, value] : values) {
+        putString(buffer, key);
+        putString(buffer, value);
+    }
+}
+
+void encodeJournalRecord(std::string& buffer, const JournalRecord& record) {
+    size_t headerPos = buffer.size();
+    buffer.append(JournalRecordHeaderSize, '\0');
+
+    put<uint64_t>(buffer, record.seq);
+    put<int64_t>(buffer, record.timestampMs);
+    put<uint8_t>(buffer, record.keyframe ? 1 : 0);
+    put<uint8_t>(buffer, static_cast<uint8_t>(record.elementType));
+    putString(buffer, record.currentElement);
+    putMap(buffer, record.inputValues);
+    putMap(buffer, record.outputValues);
+    putMap(buffer, record.internalValues);
+
+    size_t payloadPos = headerPos + JournalRecordHeaderSize;
+    uint32_t length = static_cast<uint32_t>(buffer.size() - payloadPos);
+    uint32_t checksum = journalChecksum(buffer.data() + payloadPos, length);
+    std::memcpy(&buffer[headerPos], &length, sizeof(length));
+    std::memcpy(&buffer[headerPos + sizeof(length)], &checksum, sizeof(checksum));
+}
+
+/**
+ * @class PayloadCursor
+ * @brief Bounds-checked reading of a record payload.
+ */
+class PayloadCursor {
+public:
+    PayloadCursor(const char* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (size - pos < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string& str) {
+        uint32_t length = 0;
+        if (!get(length) || size - pos < length) {
+            return false;
+        }
+        str.assign(data + pos, length);
+        pos += length;
+        return true;
+    }
+
+    bool getMap(std::map<std::string, std::string>& values) {
+        uint32_t count = 0;
+        if (!get(count)) {
+            return false;
+        }
+        values.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string key, value;
+            if (!getString(key) || !getString(value)) {
+                return false;
+            }
+            values.emplace_hint(values.end(), std::move(key), std::move(value));
+        }
+        return true;
+    }
+
+    bool atEnd() const {
+        return pos == size;
+    }
+
+private:
+    const char* data;   /**< Payload bytes. */
+    size_t size;        /**< Payload size. */
+    size_t pos = 0;     /**< Read position. */
+};
+
+bool decodeJournalRecord(const char* data, size_t size, JournalRecord& record) {
+    PayloadCursor cursor(data, size);
+    uint8_t keyframe = 0;
+    uint8_t elementType = 0;
+
+    if (!cursor.get(record.seq) || !cursor.get(record.timestampMs) ||
+        !cursor.get(keyframe) || !cursor.get(elementType) ||
+        !cursor.getString(record.currentElement) ||
+        !cursor.getMap(record.inputValues) ||
+        !cursor.getMap(record.outputValues) ||
+        !cursor.getMap(record.internalValues)) {
+        return false;
+    }
+
+    record.keyframe = keyframe != 0;
+    record.elementType = elementType == 0 ? EItemType::STATE : EItemType::TRANSITION;
+    return cursor.atEnd();
+}
@@ -0,0 +1,331 @@
+/**
+ * @file JournalReader.cpp
+ * @brief Implementation of the JournalReader querying the binary journal.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "Journal.h"
+#include "../logger/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @class SegmentCursor
+ * @brief Sequential buffered decoding of the records of a segment.
+ */
+class SegmentCursor {
+public:
+    /** @brief Size of the read buffer. */
+    static constexpr size_t ChunkSize = 1024 * 1024;
+
+    /**
+     * @brief Opens the segment and positions the cursor at the offset.
+     * @param path Path of the segment.
+     * @param offset Offset of the first record to decode.
+     */
+    SegmentCursor(const std::string& path, uint64_t offset) : offset(offset) {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            FSM_LOG_WARNING("Cannot open journal segment " + path + ": " + strerror(errno));
+        }
+    }
+
+    ~SegmentCursor() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    SegmentCursor(const SegmentCursor&) = delete;
+    SegmentCursor& operator=(const SegmentCursor&) = delete;
+
+    /**
+     * @brief Decodes the next record as stored (full or delta).
+     * @param record Receives the record.
+     * @return False at the end of the segment or at a damaged record.
+     */
+    bool next(JournalRecord& record) {
+        uint32_t header[2];
+        if (!ensure(JournalRecordHeaderSize)) {
+            return false;
+        }
+        std::memcpy(header, buffer.data() + pos, sizeof(header));
+        // A torn or damaged length must not size the buffer before the checksum is known
+        if (!withinFile(offset + JournalRecordHeaderSize + header[0])) {
+            FSM_LOG_WARNING("Journal record at offset " + std::to_string(offset) + " ends past the segment");
+            return false;
+        }
+        if (!ensure(JournalRecordHeaderSize + header[0])) {
+            return false;
+        }
+
+        const char* payload = buffer.data() + pos + JournalRecordHeaderSize;
+        if (journalChecksum(payload, header[0]) != header[1] ||
+            !decodeJournalRecord(payload, header[0], record)) {
+            FSM_LOG_WARNING("Damaged journal record at offset " + std::to_string(offset));
+            return false;
+        }
+
+        pos += JournalRecordHeaderSize + header[0];
+        offset += JournalRecordHeaderSize + header[0];
+        return true;
+    }
+
+private:
+    /**
+     * @brief Checks that the segment is at least as long as the given offset.
+     * @param end Offset the segment has to reach.
+     * @return False if the segment is shorter.
+     */
+    bool withinFile(uint64_t end) {
+        if (end <= fileSize) {
+            return true;
+        }
+        // The writer may have appended since the last check
+        struct stat info;
+        if (fd < 0 || ::fstat(fd, &info) != 0) {
+            return false;
+        }
+        fileSize = static_cast<uint64_t>(info.st_size);
+        return end <= fileSize;
+    }
+
+    /**
+     * @brief Makes sure the given number of bytes is buffered at the read position.
+     * @param size Number of bytes needed.
+     * @return False if the segment ends earlier.
+     */
+    bool ensure(size_t size) {
+        if (fd < 0) {
+            return false;
+        }
+        if (buffer.size() - pos >= size) {
+            return true;
+        }
+
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+        pos = 0;
+        while (buffer.size() < size) {
+            size_t have = buffer.size();
+            size_t want = std::max(ChunkSize, size - have);
+            buffer.resize(have + want);
+            ssize_t got = ::pread(fd, buffer.data() + have, want, static_cast<off_t>(offset + have));
+            if (got < 0 && errno == EINTR) {
+                buffer.resize(have);
+                continue;
+            }
+            buffer.resize(have + (got > 0 ? static_cast<size_t>(got) : 0));
+            if (got <= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int fd = -1;                /**< Segment descriptor. */
+    uint64_t offset;            /**< File offset of the read position. */
+    uint64_t fileSize = 0;      /**< Segment size when last checked. */
+    std::vector<char> buffer;   /**< Bytes read from offset on. */
+    size_t pos = 0;             /**< Read position in the buffer. */
+};
+
+/**
+ * @brief Applies the stored values of a record to the running state.
+ * @param state The full state, updated in place.
+ * @param stored Record as decoded from the segment.
+ */
+static void applyRecord(JournalRecord& state, JournalRecord& stored) {
+    if (stored.keyframe) {
+        state.inputValues.swap(stored.inputValues);
+        state.outputValues.swap(stored.outputValues);
+        state.internalValues.swap(stored.internalValues);
+    } else {
+        for (auto& [key, value] : stored.inputValues) state.inputValues[key] = std::move(value);
+        for (auto& [key, value] : stored.outputValues) state.outputValues[key] = std::move(value);
+        for (auto& [key, value] : stored.internalValues) state.internalValues[key] = std::move(value);
+    }
+    state.seq = stored.seq;
+    state.timestampMs = stored.timestampMs;
+    state.keyframe = stored.keyframe;
+    state.elementType = stored.elementType;
+    state.currentElement.swap(stored.currentElement);
+}
+
+JournalReader::JournalReader(const std::string& directory) : directory(directory) {}
+
+bool JournalReader::open() {
+    segments.clear();
+
+    std::error_code error;
+    std::filesystem::directory_iterator it(directory, error);
+    if (error) {
+        return false;
+    }
+
+    for (const auto& entry : it) {
+        const std::filesystem::path& path = entry.path();
+        std::string stem = path.stem().string();
+        if (path.extension() != ".fjl" || stem.rfind("journal-", 0) != 0) {
+            continue;
+        }
+
+        // Stray files such as "journal-abc.fjl" are not segments
+        Segment segment;
+        const char* first = stem.data() + 8;
+        const char* last = stem.data() + stem.size();
+        auto [end, parseError] = std::from_chars(first, last, segment.firstSeq);
+        if (first == last || parseError != std::errc() || end != last) {
+            continue;
+        }
+        segment.path = path.string();
+
+        // Load the sparse index, a missing or short index only costs a longer scan
+        std::filesystem::path indexPath = path;
+        indexPath.replace_extension(".idx");
+        int fd = ::open(indexPath.string().c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            uint32_t header[2] = {0, 0};
+            if (::read(fd, header, sizeof(header)) == sizeof(header) &&
+                header[0] == JournalIndexMagic && header[1] == JournalVersion) {
+                JournalIndexEntry indexEntry;
+                while (::read(fd, &indexEntry, sizeof(indexEntry)) == sizeof(indexEntry)) {
+                    segment.index.push_back(indexEntry);
+                }
+            }
+            ::close(fd);
+        }
+
+        // Every segment starts with a keyframe right after the header
+        if (segment.index.empty()) {
+            SegmentCursor cursor(segment.path, JournalFileHeaderSize);
+            JournalRecord first;
+            if (!cursor.next(first)) {
+                continue;
+            }
+            segment.index.push_back({first.seq, first.timestampMs, JournalFileHeaderSize});
+        }
+        segments.push_back(std::move(segment));
+    }
+
+    std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) {
+        return a.firstSeq < b.firstSeq;
+    });
+    return !segments.empty();
+}
+
+/**
+ * @brief Finds the position of the last element that starts before (or at) the timestamp.
+ * @param first Begin of a range ordered by timestamp.
+ * @param last End of the range.
+ * @param timestampMs The timestamp.
+ * @param inclusive Whether an element starting exactly at the timestamp qualifies.
+ * @param startOf Gets the start timestamp of an element.
+ * @return Offset of the element, 0 if none qualifies.
+ */
+template <typename Iterator, typename StartOf>
+static size_t lastStartingBefore(Iterator first, Iterator last, int64_t timestampMs, bool inclusive, StartOf startOf) {
+    Iterator after = inclusive
+        ? std::upper_bound(first, last, timestampMs, [&](int64_t ts, const auto& item) { return ts < startOf(item); })
+        : std::lower_bound(first, last, timestampMs, [&](const auto& item, int64_t ts) { return startOf(item) < ts; });
+    return after == first ? 0 : static_cast<size_t>(after - first - 1);
+}
+
+size_t JournalReader::segmentFor(int64_t timestampMs, bool inclusive) const {
+    return lastStartingBefore(segments.begin(), segments.end(), timestampMs, inclusive,
+        [](const Segment& segment) { return segment.index.front().timestampMs; });
+}
+
+void JournalReader::scanSegment(const Segment& segment, int64_t timestampMs, bool inclusive,
+                                const std::function<bool(const JournalRecord&)>& visitor) const {
+    size_t start = lastStartingBefore(segment.index.begin(), segment.index.end(), timestampMs, inclusive,
+        [](const JournalIndexEntry& entry) { return entry.timestampMs; });
+
+    SegmentCursor cursor(segment.path, segment.index[start].offset);
+    JournalRecord state;
+    JournalRecord stored;
+    while (cursor.next(stored)) {
+        applyRecord(state, stored);
+        if (!visitor(state)) {
+            return;
+        }
+    }
+}
+
+void JournalReader::forEachInRange(int64_t fromMs, int64_t toMs,
+                                   const std::function<bool(const JournalRecord&)>& visitor) const {
+    // Records stamped exactly fromMs may precede a keyframe with the same stamp, so start strictly before it
+    bool finished = false;
+    for (size_t i = segmentFor(fromMs, false); i < segments.size() && !finished; ++i) {
+        if (segments[i].index.front().timestampMs > toMs) {
+            break;
+        }
+        scanSegment(segments[i], fromMs, false, [&](const JournalRecord& record) {
+            if (record.timestampMs < fromMs) {
+                return true;
+            }
+            if (record.timestampMs > toMs || !visitor(record)) {
+                finished = true;
+                return false;
+            }
+            return true;
+        });
+    }
+}
+
+std::vector<JournalRecord> JournalReader::query(int64_t fromMs, int64_t toMs) const {
+    std::vector<JournalRecord> records;
+    forEachInRange(fromMs, toMs, [&records](const JournalRecord& record) {
+        records.push_back(record);
+        return true;
+    });
+    return records;
+}
+
+bool JournalReader::stateAt(int64_t timestampMs, JournalRecord& record) const {
+    if (segments.empty() || segments.front().index.front().timestampMs > timestampMs) {
+        return false;
+    }
+
+    bool found = false;
+    scanSegment(segments[segmentFor(timestampMs, true)], timestampMs, true, [&](const JournalRecord& state) {
+        if (state.timestampMs > timestampMs) {
+            return false;
+        }
+        record = state;
+        found = true;
+        return true;
+    });
+    return found;
+}
+
+bool JournalReader::lastRecord(JournalRecord& record) const {
+    if (segments.empty()) {
+        return false;
+    }
+
+    bool found = false;
+    const Segment& last = segments.back();
+    scanSegment(last, last.index.back().timestampMs, true, [&](const JournalRecord& state) {
+        record = state;
+        found = true;
+        return true;
+    });
+    return found;
+}
+
+bool JournalReader::timeBounds(int64_t& firstMs, int64_t& lastMs) const {
+    JournalRecord last;
+    if (!lastRecord(last)) {
+        return false;
+    }
+    firstMs = segments.front().index.front().timestampMs;
+    lastMs = last.timestampMs;
+    return true;
+}
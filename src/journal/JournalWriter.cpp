@@ -0,0 +1,260 @@
+/**
+ * @file JournalWriter.cpp
+ * @brief Implementation of the JournalWriter appending LOG events to the binary journal.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "Journal.h"
+#include "../logger/Logger.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief Writes the whole buffer to the descriptor.
+ * @param fd Descriptor to write to.
+ * @param data Bytes to write.
+ * @return False on a write error.
+ */
+static bool writeAll(int fd, const std::string& data) {
+    const char* pos = data.data();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, pos, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        pos += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Collects the entries whose value differs from the previous state.
+ * @param current Current values.
+ * @param previous Values stored with the previous record.
+ * @return The changed entries.
+ */
+static std::map<std::string, std::string> changedValues(const std::map<std::string, std::string>& current,
+                                                        const std::map<std::string, std::string>& previous) {
+    std::map<std::string, std::string> changed = {};
+    for (const auto& [key, value] : current) {
+        auto it = previous.find(key);
+        if (it == previous.end() || it->second != value) {
+            changed.emplace_hint(changed.end(), key, value);
+        }
+    }
+    return changed;
+}
+
+JournalWriter::JournalWriter(const std::string& directory, uint64_t segmentBytes,
+                             uint32_t keyframeInterval, int syncIntervalMs)
+    : directory(directory),
+      segmentBytes(segmentBytes),
+      keyframeInterval(keyframeInterval == 0 ? 1 : keyframeInterval),
+      syncIntervalMs(syncIntervalMs) {
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        FSM_LOG_ERROR("Cannot create journal directory " + directory + ": " + error.message());
+        return;
+    }
+
+    // Continue the numbering of an existing journal
+    JournalReader existing(directory);
+    JournalRecord last;
+    if (existing.open() && existing.lastRecord(last)) {
+        nextSeq = last.seq + 1;
+    }
+
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (!openSegment(nextSeq)) {
+        return;
+    }
+    syncThread = std::thread(&JournalWriter::syncLoop, this);
+    FSM_LOG_INFO("Journaling LOG messages to " + directory);
+}
+
+JournalWriter::~JournalWriter() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    if (syncThread.joinable()) {
+        syncThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(writerMutex);
+    closeSegment();
+}
+
+bool JournalWriter::isOpen() const {
+    return segmentFd >= 0;
+}
+
+void JournalWriter::append(int64_t timestampMs,
+                           EItemType elementType,
+                           const std::string& currentElement,
+                           const std::map<std::string, std::string>& inputValues,
+                           const std::map<std::string, std::string>& outputValues,
+                           const std::map<std::string, std::string>& internalValues) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (segmentFd < 0) {
+        return;
+    }
+
+    if (segmentSize >= segmentBytes) {
+        closeSegment();
+        if (!openSegment(nextSeq)) {
+            return;
+        }
+    }
+
+    JournalRecord record;
+    record.seq = nextSeq++;
+    record.timestampMs = timestampMs;
+    record.elementType = elementType;
+    record.currentElement = currentElement;
+    record.keyframe = sinceKeyframe == 0;
+
+    if (record.keyframe) {
+        record.inputValues = inputValues;
+        record.outputValues = outputValues;
+        record.internalValues = internalValues;
+
+        JournalIndexEntry entry{record.seq, timestampMs, segmentSize};
+        indexBuffer.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    } else {
+        record.inputValues = changedValues(inputValues, lastInputs);
+        record.outputValues = changedValues(outputValues, lastOutputs);
+        record.internalValues = changedValues(internalValues, lastInternals);
+    }
+
+    size_t before = segmentBuffer.size();
+    encodeJournalRecord(segmentBuffer, record);
+    segmentSize += segmentBuffer.size() - before;
+    sinceKeyframe = (sinceKeyframe + 1) % keyframeInterval;
+
+    lastInputs = inputValues;
+    lastOutputs = outputValues;
+    lastInternals = internalValues;
+
+    if (segmentBuffer.size() >= BufferLimit) {
+        writeBuffers(false);
+    }
+}
+
+void JournalWriter::flush(bool sync) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    writeBuffers(sync);
+}
+
+std::string JournalWriter::directoryFromEnvironment() {
+    const char* configured = std::getenv("FSMCRAFT_JOURNAL_DIR");
+    return configured ? configured : "";
+}
+
+bool JournalWriter::openSegment(uint64_t firstSeq) {
+    std::string segmentPath = (std::filesystem::path(directory) / journalFileName(firstSeq, ".fjl")).string();
+    std::string indexPath = (std::filesystem::path(directory) / journalFileName(firstSeq, ".idx")).string();
+
+    segmentFd = ::open(segmentPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segmentFd < 0) {
+        FSM_LOG_ERROR("Cannot open journal segment " + segmentPath + ": " + strerror(errno));
+        return false;
+    }
+    indexFd = ::open(indexPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (indexFd < 0) {
+        FSM_LOG_ERROR("Cannot open journal index " + indexPath + ": " + strerror(errno));
+        ::close(segmentFd);
+        segmentFd = -1;
+        return false;
+    }
+
+    uint32_t header[2] = {JournalSegmentMagic, JournalVersion};
+    segmentBuffer.assign(reinterpret_cast<const char*>(header), sizeof(header));
+    header[0] = JournalIndexMagic;
+    indexBuffer.assign(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // Every segment is self-contained, so it starts with a keyframe
+    segmentSize = JournalFileHeaderSize;
+    sinceKeyframe = 0;
+    return true;
+}
+
+void JournalWriter::closeSegment() {
+    if (segmentFd < 0) {
+        return;
+    }
+    writeBuffers(true);
+    ::close(segmentFd);
+    ::close(indexFd);
+    segmentFd = -1;
+    indexFd = -1;
+}
+
+void JournalWriter::writeBuffers(bool sync) {
+    if (segmentFd < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> ioLock(ioMutex);
+    writeOut(segmentFd, indexFd, segmentBuffer, indexBuffer, sync);
+    segmentBuffer.clear();
+    indexBuffer.clear();
+}
+
+void JournalWriter::writeOut(int segmentFd, int indexFd,
+                             const std::string& segmentData, const std::string& indexData, bool sync) {
+    // The segment goes first, an index entry never points past the written data
+    if (!segmentData.empty() && !writeAll(segmentFd, segmentData)) {
+        FSM_LOG_ERROR(std::string("Journal write failed: ") + strerror(errno));
+    }
+    if (sync) {
+        fdatasync(segmentFd);
+    }
+    if (!indexData.empty() && !writeAll(indexFd, indexData)) {
+        FSM_LOG_ERROR(std::string("Journal index write failed: ") + strerror(errno));
+    }
+    if (sync) {
+        fdatasync(indexFd);
+    }
+}
+
+void JournalWriter::syncLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    std::string segmentData;
+    std::string indexData;
+
+    while (!stopping) {
+        stopSignal.wait_for(lock, std::chrono::milliseconds(syncIntervalMs));
+        if (stopping || segmentFd < 0) {
+            continue;
+        }
+
+        // Take the buffers and write them without blocking append()
+        segmentData.swap(segmentBuffer);
+        indexData.swap(indexBuffer);
+        std::unique_lock<std::mutex> ioLock(ioMutex);
+        int segment = segmentFd;
+        int index = indexFd;
+        lock.unlock();
+
+        writeOut(segment, index, segmentData, indexData, true);
+        segmentData.clear();
+        indexData.clear();
+
+        ioLock.unlock();
+        lock.lock();
+    }
+}
@@ -0,0 +1,292 @@
+/**
+ * @file ForceLayout.cpp
+ * @brief Implementation of the force-directed layout of FSM graphs.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "ForceLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/**
+ * @class QuadTree
+ * @brief Barnes-Hut quadtree over the state positions, rebuilt every iteration.
+ */
+class QuadTree {
+public:
+    /** @brief Depth at which coincident states stop being split and share a leaf. */
+    static constexpr int MaxDepth = 32;
+
+    /**
+     * @brief Builds the tree over all positions.
+     * @param positions Positions of the states.
+     */
+    explicit QuadTree(const std::vector<LayoutPoint>& positions) : positions(positions) {
+        double minX = positions[0].x, maxX = minX, minY = positions[0].y, maxY = minY;
+        for (const LayoutPoint& p : positions) {
+            minX = std::min(minX, p.x);
+            maxX = std::max(maxX, p.x);
+            minY = std::min(minY, p.y);
+            maxY = std::max(maxY, p.y);
+        }
+
+        nodes.reserve(positions.size() * 2);
+        nodes.push_back(Node());
+        nodes[0].centerX = (minX + maxX) / 2;
+        nodes[0].centerY = (minY + maxY) / 2;
+        nodes[0].half = std::max(maxX - minX, maxY - minY) / 2 + 1.0;
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            insert(0, i, 0);
+        }
+    }
+
+    /**
+     * @brief Sums the repulsion of all other states acting on one state.
+     * @param index Index of the state.
+     * @param k2 Square of the preferred edge length.
+     * @param theta Opening angle.
+     * @param forceX Receives the horizontal force.
+     * @param forceY Receives the vertical force.
+     */
+    void repulsion(size_t index, double k2, double theta, double& forceX, double& forceY) const {
+        const LayoutPoint& p = positions[index];
+        const double theta2 = theta * theta;
+        forceX = 0.0;
+        forceY = 0.0;
+
+        int stack[4 * MaxDepth + 4];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            if (node.mass == 0) {
+                continue;
+            }
+
+            double dx = p.x - node.massX / node.mass;
+            double dy = p.y - node.massY / node.mass;
+            double dist2 = dx * dx + dy * dy;
+            double size = node.half * 2;
+
+            // Far enough (or a leaf): the whole cell acts as one body in its center of mass
+            if (node.child[0] < 0 || size * size < theta2 * dist2) {
+                if (node.child[0] < 0 && node.body == static_cast<long>(index) && node.mass == 1) {
+                    continue;
+                }
+                if (dist2 < 1e-4) {
+                    // Coincident states, push apart in a direction given by the index
+                    dx = std::cos(static_cast<double>(index));
+                    dy = std::sin(static_cast<double>(index));
+                    dist2 = 1.0;
+                }
+                double mass = node.mass - (node.child[0] < 0 && node.body == static_cast<long>(index) ? 1 : 0);
+                double scale = k2 * mass / dist2;
+                forceX += dx * scale;
+                forceY += dy * scale;
+                continue;
+            }
+
+            for (int c : node.child) {
+                stack[top++] = c;
+            }
+        }
+    }
+
+private:
+    /**
+     * @struct Node
+     * @brief Square cell of the tree.
+     */
+    struct Node {
+        double centerX = 0.0;       /**< Center of the cell. */
+        double centerY = 0.0;       /**< Center of the cell. */
+        double half = 0.0;          /**< Half of the cell side. */
+        double massX = 0.0;         /**< Sum of the x coordinates of contained states. */
+        double massY = 0.0;         /**< Sum of the y coordinates of contained states. */
+        int mass = 0;               /**< Number of contained states. */
+        long body = -1;             /**< The contained state of a leaf, -1 if none. */
+        int child[4] = {-1, -1, -1, -1}; /**< Quadrants, -1 for a leaf. */
+    };
+
+    /**
+     * @brief Inserts a state into the subtree.
+     * @param nodeIndex Root of the subtree.
+     * @param index Index of the state.
+     * @param depth Depth of the subtree root.
+     */
+    void insert(int nodeIndex, size_t index, int depth) {
+        const LayoutPoint& p = positions[index];
+        while (true) {
+            Node& node = nodes[nodeIndex];
+            node.massX += p.x;
+            node.massY += p.y;
+            ++node.mass;
+
+            if (node.child[0] < 0) {
+                if (node.mass == 1) {
+                    node.body = static_cast<long>(index);
+                    return;
+                }
+                if (depth >= MaxDepth) {
+                    return;     // coincident states share the leaf
+                }
+                split(nodeIndex);
+                // Move the previous body one level down, without counting it twice here
+                long previous = nodes[nodeIndex].body;
+                nodes[nodeIndex].body = -1;
+                int target = quadrant(nodes[nodeIndex], positions[static_cast<size_t>(previous)]);
+                Node& child = nodes[static_cast<size_t>(nodes[nodeIndex].child[target])];
+                child.massX = positions[static_cast<size_t>(previous)].x;
+                child.massY = positions[static_cast<size_t>(previous)].y;
+                child.mass = 1;
+                child.body = previous;
+            }
+
+            nodeIndex = nodes[nodeIndex].child[quadrant(nodes[nodeIndex], p)];
+            ++depth;
+        }
+    }
+
+    /**
+     * @brief Creates the four quadrants of a leaf.
+     * @param nodeIndex The leaf.
+     */
+    void split(int nodeIndex) {
+        double half = nodes[nodeIndex].half / 2;
+        for (int q = 0; q < 4; ++q) {
+            Node child;
+            child.half = half;
+            child.centerX = nodes[nodeIndex].centerX + ((q & 1) ? half : -half);
+            child.centerY = nodes[nodeIndex].centerY + ((q & 2) ? half : -half);
+            nodes[nodeIndex].child[q] = static_cast<int>(nodes.size());
+            nodes.push_back(child);
+        }
+    }
+
+    /**
+     * @brief Selects the quadrant of a cell containing a point.
+     * @param node The cell.
+     * @param p The point.
+     * @return Quadrant number 0-3.
+     */
+    static int quadrant(const Node& node, const LayoutPoint& p) {
+        return (p.x >= node.centerX ? 1 : 0) | (p.y >= node.centerY ? 2 : 0);
+    }
+
+    const std::vector<LayoutPoint>& positions;  /**< Positions the tree was built over. */
+    std::vector<Node> nodes;                    /**< Cells, the root is at index 0. */
+};
+
+ForceLayout::ForceLayout(size_t nodeCount, std::vector<LayoutEdge> edges, LayoutParams params)
+    : nodeCount(nodeCount), params(params) {
+    for (const LayoutEdge& edge : edges) {
+        if (edge.first != edge.second && edge.first < nodeCount && edge.second < nodeCount) {
+            this->edges.push_back(edge);
+        }
+    }
+}
+
+bool ForceLayout::run(std::vector<LayoutPoint>& positions, const std::atomic<bool>& cancelled) const {
+    if (nodeCount == 0 || positions.size() != nodeCount) {
+        return !cancelled.load();
+    }
+
+    const double k = params.edgeLength;
+    const double k2 = k * k;
+    unsigned threads = params.threads ? params.threads : std::max(1u, std::thread::hardware_concurrency());
+    if (nodeCount < ParallelThreshold) {
+        threads = 1;
+    }
+
+    std::vector<LayoutPoint> current = positions;
+    std::vector<LayoutPoint> displacement(nodeCount);
+
+    // Start hot enough to untangle the initial grid, cool down linearly to zero
+    const double startTemperature = k * std::sqrt(static_cast<double>(nodeCount)) / 4 + k;
+
+    for (int iteration = 0; iteration < params.iterations; ++iteration) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        double centerX = 0.0, centerY = 0.0;
+        for (const LayoutPoint& p : current) {
+            centerX += p.x;
+            centerY += p.y;
+        }
+        centerX /= static_cast<double>(nodeCount);
+        centerY /= static_cast<double>(nodeCount);
+
+        // Repulsion and gravity, every thread writes only its own range of displacements
+        QuadTree tree(current);
+        auto repel = [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                double fx, fy;
+                tree.repulsion(i, k2, params.theta, fx, fy);
+                displacement[i].x = fx - (current[i].x - centerX) * params.gravity * k;
+                displacement[i].y = fy - (current[i].y - centerY) * params.gravity * k;
+            }
+        };
+
+        if (threads == 1) {
+            repel(0, nodeCount);
+        } else {
+            std::vector<std::thread> workers;
+            size_t chunk = (nodeCount + threads - 1) / threads;
+            for (unsigned t = 1; t < threads; ++t) {
+                size_t from = std::min(nodeCount, t * chunk);
+                size_t to = std::min(nodeCount, from + chunk);
+                workers.emplace_back(repel, from, to);
+            }
+            repel(0, std::min(nodeCount, chunk));
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        // Attraction along transitions
+        for (const LayoutEdge& edge : edges) {
+            double dx = current[edge.first].x - current[edge.second].x;
+            double dy = current[edge.first].y - current[edge.second].y;
+            double dist = std::sqrt(dx * dx + dy * dy);
+            if (dist < 1e-6) {
+                continue;
+            }
+            double scale = dist / k;
+            displacement[edge.first].x -= dx * scale;
+            displacement[edge.first].y -= dy * scale;
+            displacement[edge.second].x += dx * scale;
+            displacement[edge.second].y += dy * scale;
+        }
+
+        // Move every state at most by the current temperature
+        double temperature = startTemperature * (1.0 - static_cast<double>(iteration) / params.iterations);
+        for (size_t i = 0; i < nodeCount; ++i) {
+            double length = std::sqrt(displacement[i].x * displacement[i].x + displacement[i].y * displacement[i].y);
+            if (length < 1e-9) {
+                continue;
+            }
+            double step = std::min(length, temperature) / length;
+            current[i].x += displacement[i].x * step;
+            current[i].y += displacement[i].y * step;
+        }
+    }
+
+    double centerX = 0.0, centerY = 0.0;
+    for (const LayoutPoint& p : current) {
+        centerX += p.x;
+        centerY += p.y;
+    }
+    centerX /= static_cast<double>(nodeCount);
+    centerY /= static_cast<double>(nodeCount);
+    for (LayoutPoint& p : current) {
+        p.x -= centerX;
+        p.y -= centerY;
+    }
+
+    positions.swap(current);
+    return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file ForceLayout.h
+ * @brief Header file for the force-directed layout of FSM graphs.
+ *
+ * Fruchterman-Reingold layout: edges pull their states together, all states push each other
+ * apart, and the step size cools down every iteration. The all-pairs repulsion is
+ * approximated with a Barnes-Hut quadtree, so an iteration costs O(n log n) instead of
+ * O(n^2), and is split over worker threads by ranges of states.
+ *
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct LayoutPoint
+ * @brief Position of a state center in scene coordinates.
+ */
+struct LayoutPoint {
+    double x = 0.0;     /**< Horizontal coordinate. */
+    double y = 0.0;     /**< Vertical coordinate. */
+};
+
+/** @brief Edge between two states given by their indexes. */
+using LayoutEdge = std::pair<size_t, size_t>;
+
+/**
+ * @struct LayoutParams
+ * @brief Tuning of the layout.
+ */
+struct LayoutParams {
+    int iterations = 300;           /**< Number of cooling steps. */
+    double edgeLength = 180.0;      /**< Preferred distance of connected states. */
+    double theta = 0.9;             /**< Barnes-Hut opening angle, larger is faster and coarser. */
+    double gravity = 0.02;          /**< Pull towards the center, keeps components together. */
+    unsigned threads = 0;           /**< Worker threads, 0 for the hardware concurrency. */
+};
+
+/**
+ * @class ForceLayout
+ * @brief Computes positions of a graph, independent of the GUI and safe to run on any thread.
+ */
+class ForceLayout {
+public:
+    /** @brief Graphs smaller than this are laid out on the calling thread only. */
+    static constexpr size_t ParallelThreshold = 2000;
+
+    /**
+     * @brief Creates the layout of a graph.
+     * @param nodeCount Number of states.
+     * @param edges Transitions as pairs of state indexes, self-loops are ignored.
+     * @param params Tuning of the layout.
+     */
+    ForceLayout(size_t nodeCount, std::vector<LayoutEdge> edges, LayoutParams params = LayoutParams());
+
+    /**
+     * @brief Moves the positions to the layout, starting from the given ones.
+     * @param positions Initial positions, receives the result centered at the origin.
+     * @param cancelled Checked every iteration, the positions are left unchanged when set.
+     * @return False if the layout was cancelled.
+     */
+    bool run(std::vector<LayoutPoint>& positions, const std::atomic<bool>& cancelled) const;
+
+private:
+    size_t nodeCount;                   /**< Number of states. */
+    std::vector<LayoutEdge> edges;      /**< Edges without self-loops. */
+    LayoutParams params;                /**< Tuning of the layout. */
+};
@@ -0,0 +1,46 @@
+/**
+ * @file LayoutWorker.cpp
+ * @brief Implementation of the background thread computing graph layouts.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#include "LayoutWorker.h"
+#include "../logger/Logger.h"
+#include <chrono>
+
+LayoutWorker::~LayoutWorker() {
+    cancel();
+}
+
+uint64_t LayoutWorker::start(ForceLayout layout, std::vector<LayoutPoint> initial, Callback done) {
+    cancel();
+    cancelled.store(false);
+    uint64_t generation = current.fetch_add(1) + 1;
+
+    worker = std::thread([this, generation, layout = std::move(layout),
+                          positions = std::move(initial), done = std::move(done)]() mutable {
+        auto begin = std::chrono::steady_clock::now();
+        if (!layout.run(positions, cancelled)) {
+            FSM_LOG_DEBUG("Layout " + std::to_string(generation) + " cancelled.");
+            return;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin);
+        FSM_LOG_INFO("Laid out " + std::to_string(positions.size()) + " states in " +
+                     std::to_string(elapsed.count()) + " ms.");
+        done(generation, std::move(positions));
+    });
+    return generation;
+}
+
+void LayoutWorker::cancel() {
+    cancelled.store(true);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+uint64_t LayoutWorker::generation() const {
+    return current.load();
+}
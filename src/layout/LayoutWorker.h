@@ -0,0 +1,64 @@
+/**
+ * @file LayoutWorker.h
+ * @brief Header file for the background thread computing graph layouts.
+ * @author xmarina00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "ForceLayout.h"
+
+/**
+ * @class LayoutWorker
+ * @brief Runs one ForceLayout at a time on its own thread.
+ *
+ * Starting a new layout cancels the running one. Every layout gets a generation number
+ * that is passed to the callback, so the receiver can drop results of a graph that was
+ * replaced in the meantime.
+ */
+class LayoutWorker {
+public:
+    /** @brief Receives the generation and the positions, called on the worker thread. */
+    using Callback = std::function<void(uint64_t, std::vector<LayoutPoint>)>;
+
+    LayoutWorker() = default;
+
+    /**
+     * @brief Cancels the running layout and waits for the thread.
+     */
+    ~LayoutWorker();
+
+    LayoutWorker(const LayoutWorker&) = delete;
+    LayoutWorker& operator=(const LayoutWorker&) = delete;
+
+    /**
+     * @brief Starts laying out a graph, cancelling the previous layout.
+     * @param layout The graph and its tuning.
+     * @param initial Initial positions, one per state.
+     * @param done Called with the result unless the layout is cancelled.
+     * @return Generation of the started layout.
+     */
+    uint64_t start(ForceLayout layout, std::vector<LayoutPoint> initial, Callback done);
+
+    /**
+     * @brief Cancels the running layout and waits until its thread ends.
+     */
+    void cancel();
+
+    /**
+     * @brief Gets the generation of the most recently started layout.
+     * @return Generation number, 0 before the first start.
+     */
+    uint64_t generation() const;
+
+private:
+    std::thread worker;                 /**< Thread of the running layout. */
+    std::atomic<bool> cancelled{false}; /**< Stops the running layout. */
+    std::atomic<uint64_t> current{0};   /**< Generation of the most recent layout. */
+};
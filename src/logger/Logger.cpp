@@ -0,0 +1,208 @@
+/**
+ * @file Logger.cpp
+ * @brief Implementation of the asynchronous leveled logger.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+namespace {
+
+/** @brief Interval after which the writer drains buffers without being woken up. */
+constexpr std::chrono::milliseconds DrainInterval(10);
+
+void shutdownAtExit() {
+    Logger::instance().shutdown();
+}
+
+}
+
+bool Logger::ThreadBuffer::push(Record&& record) {
+    size_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - head.load(std::memory_order_acquire) >= Capacity) {
+        return false;
+    }
+    slots[currentTail & (Capacity - 1)] = std::move(record);
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::ThreadBuffer::pop(Record& record) {
+    size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    record = std::move(slots[currentHead & (Capacity - 1)]);
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
+
+Logger::BufferHandle::~BufferHandle() {
+    if (buffer) {
+        buffer->orphaned.store(true, std::memory_order_release);
+    }
+}
+
+Logger& Logger::instance() {
+    // Never destroyed, detached threads may still log while static objects are torn down
+    static Logger* logger = [] {
+        Logger* created = new Logger();
+        std::atexit(shutdownAtExit);
+        return created;
+    }();
+    return *logger;
+}
+
+Logger::Logger() : level(static_cast<int>(ELogLevel::INFO)) {
+    const char* envLevel = std::getenv("FSMCRAFT_LOG_LEVEL");
+    if (envLevel) {
+        level.store(static_cast<int>(logLevelFromString(envLevel)));
+    }
+    writer = std::thread(&Logger::writerLoop, this);
+}
+
+void Logger::setLevel(ELogLevel newLevel) {
+    level.store(static_cast<int>(newLevel), std::memory_order_relaxed);
+}
+
+ELogLevel Logger::getLevel() const {
+    return static_cast<ELogLevel>(level.load(std::memory_order_relaxed));
+}
+
+bool Logger::isEnabled(ELogLevel recordLevel) const {
+    return recordLevel != ELogLevel::NONE &&
+           static_cast<int>(recordLevel) >= level.load(std::memory_order_relaxed);
+}
+
+Logger::ThreadBuffer& Logger::localBuffer() {
+    thread_local BufferHandle handle;
+    if (!handle.buffer) {
+        handle.buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(handle.buffer);
+    }
+    return *handle.buffer;
+}
+
+void Logger::log(ELogLevel recordLevel, std::string message) {
+    Record record;
+    record.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+    record.level = recordLevel;
+    record.time = std::chrono::system_clock::now();
+    record.text = std::move(message);
+
+    if (!localBuffer().push(std::move(record))) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Logger::droppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void Logger::drain(std::vector<Record>& batch) {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto it = buffers.begin(); it != buffers.end();) {
+        ThreadBuffer& buffer = **it;
+        // Read the flag first so nothing pushed before the thread exited is missed
+        bool orphaned = buffer.orphaned.load(std::memory_order_acquire);
+        Record record;
+        while (buffer.pop(record)) {
+            batch.push_back(std::move(record));
+        }
+        it = orphaned ? buffers.erase(it) : it + 1;
+    }
+
+    std::sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) {
+        return a.sequence < b.sequence;
+    });
+}
+
+void Logger::write(const std::vector<Record>& batch) {
+    std::string out;
+    std::string err;
+
+    for (const Record& record : batch) {
+        std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            record.time.time_since_epoch()).count() % 1000;
+        std::tm local{};
+        localtime_r(&seconds, &local);
+
+        char prefix[32];
+        std::snprintf(prefix, sizeof(prefix), "[%02d:%02d:%02d.%03d] ",
+            local.tm_hour, local.tm_min, local.tm_sec, static_cast<int>(millis));
+
+        std::string& target = record.level >= ELogLevel::WARNING ? err : out;
+        target += prefix;
+        target += eLogLevelToString(record.level);
+        target += ' ';
+        target += record.text;
+        target += '\n';
+    }
+
+    if (!out.empty()) {
+        std::cout.write(out.data(), out.size());
+        std::cout.flush();
+    }
+    if (!err.empty()) {
+        std::cerr.write(err.data(), err.size());
+        std::cerr.flush();
+    }
+}
+
+void Logger::writerLoop() {
+    std::vector<Record> batch;
+    uint64_t reportedDrops = 0;
+
+    while (true) {
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        batch.clear();
+        drain(batch);
+
+        uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            Record notice;
+            notice.level = ELogLevel::WARNING;
+            notice.time = std::chrono::system_clock::now();
+            notice.text = "Logger dropped " + std::to_string(drops - reportedDrops) + " records.";
+            batch.push_back(std::move(notice));
+            reportedDrops = drops;
+        }
+
+        if (!batch.empty()) {
+            write(batch);
+        }
+
+        if (stopping) {
+            break;
+        }
+
+        if (batch.empty()) {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, DrainInterval, [this] {
+                return !running.load(std::memory_order_acquire);
+            });
+        }
+    }
+}
+
+void Logger::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        if (!running.exchange(false)) {
+            return;
+        }
+    }
+    wake.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
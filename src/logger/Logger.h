@@ -0,0 +1,199 @@
+/**
+ * @file Logger.h
+ * @brief Header file for the asynchronous leveled logger used for diagnostics.
+ *
+ * Every thread appends records into its own lock-free buffer, a background writer drains
+ * all buffers and writes them to the terminal in batches. Debug statements are removed at
+ * compile time unless FSMCRAFT_MIN_LOG_LEVEL allows them.
+ *
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/ELogLevel.h"
+
+/**
+ * @brief Lowest level compiled into the binary (0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR).
+ */
+#ifndef FSMCRAFT_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define FSMCRAFT_MIN_LOG_LEVEL 1
+#else
+#define FSMCRAFT_MIN_LOG_LEVEL 0
+#endif
+#endif
+
+/**
+ * @brief Logs a message with the given level, the message is not evaluated when disabled.
+ */
+#define FSM_LOG(level, message)                                 \
+    do {                                                        \
+        Logger& fsmLogger = Logger::instance();                 \
+        if (fsmLogger.isEnabled(level)) {                       \
+            fsmLogger.log(level, message);                      \
+        }                                                       \
+    } while (0)
+
+#if FSMCRAFT_MIN_LOG_LEVEL <= 0
+#define FSM_LOG_DEBUG(message) FSM_LOG(ELogLevel::DEBUG, message)
+#else
+#define FSM_LOG_DEBUG(message) do {} while (0)
+#endif
+
+#if FSMCRAFT_MIN_LOG_LEVEL <= 1
+#define FSM_LOG_INFO(message) FSM_LOG(ELogLevel::INFO, message)
+#else
+#define FSM_LOG_INFO(message) do {} while (0)
+#endif
+
+#if FSMCRAFT_MIN_LOG_LEVEL <= 2
+#define FSM_LOG_WARNING(message) FSM_LOG(ELogLevel::WARNING, message)
+#else
+#define FSM_LOG_WARNING(message) do {} while (0)
+#endif
+
+#define FSM_LOG_ERROR(message) FSM_LOG(ELogLevel::ERROR, message)
+
+/**
+ * @class Logger
+ * @brief Process-wide logger that never blocks the calling thread on terminal I/O.
+ */
+class Logger {
+public:
+    /**
+     * @brief Gets the process-wide logger, starting the writer thread on first use.
+     * @return Reference to the logger.
+     */
+    static Logger& instance();
+
+    /**
+     * @brief Sets the minimal level written at runtime.
+     * @param level Records below this level are discarded.
+     */
+    void setLevel(ELogLevel level);
+
+    /**
+     * @brief Gets the minimal level written at runtime.
+     * @return The current level.
+     */
+    ELogLevel getLevel() const;
+
+    /**
+     * @brief Checks whether records of the given level are written.
+     * @param level Level to check.
+     * @return True if enabled.
+     */
+    bool isEnabled(ELogLevel level) const;
+
+    /**
+     * @brief Queues a record into the buffer of the calling thread.
+     *
+     * If the buffer is full the record is dropped and counted instead of waiting.
+     *
+     * @param level Level of the record.
+     * @param message Text of the record.
+     */
+    void log(ELogLevel level, std::string message);
+
+    /**
+     * @brief Stops the writer thread after writing all queued records.
+     */
+    void shutdown();
+
+    /**
+     * @brief Gets the number of records dropped because a buffer was full.
+     * @return Dropped record count.
+     */
+    uint64_t droppedCount() const;
+
+private:
+    /**
+     * @brief A single queued log record.
+     */
+    struct Record {
+        uint64_t sequence = 0;                          /**< Global order of the record. */
+        ELogLevel level = ELogLevel::INFO;              /**< Level of the record. */
+        std::chrono::system_clock::time_point time;     /**< Time the record was queued. */
+        std::string text;                               /**< Message text. */
+    };
+
+    /**
+     * @brief Single-producer single-consumer ring of records owned by one thread.
+     */
+    struct ThreadBuffer {
+        static constexpr size_t Capacity = 1024;        /**< Number of slots, power of two. */
+        std::array<Record, Capacity> slots;             /**< Record storage. */
+        std::atomic<size_t> head{0};                    /**< Next slot read by the writer. */
+        std::atomic<size_t> tail{0};                    /**< Next slot written by the owner. */
+        std::atomic<bool> orphaned{false};              /**< Set when the owning thread exits. */
+
+        /**
+         * @brief Appends a record, called only by the owning thread.
+         * @param record Record to move into the buffer.
+         * @return False if the buffer is full.
+         */
+        bool push(Record&& record);
+
+        /**
+         * @brief Removes the oldest record, called only by the writer.
+         * @param record Receives the record.
+         * @return False if the buffer is empty.
+         */
+        bool pop(Record& record);
+    };
+
+    /**
+     * @brief Holds the buffer of a thread and marks it orphaned when the thread exits.
+     */
+    struct BufferHandle {
+        std::shared_ptr<ThreadBuffer> buffer;
+        ~BufferHandle();
+    };
+
+    Logger();
+
+    /**
+     * @brief Gets or registers the buffer of the calling thread.
+     * @return Buffer owned by the calling thread.
+     */
+    ThreadBuffer& localBuffer();
+
+    /**
+     * @brief Moves all queued records into the batch and forgets exited threads.
+     * @param batch Receives the records ordered by sequence.
+     */
+    void drain(std::vector<Record>& batch);
+
+    /**
+     * @brief Formats and writes a batch with a single flush per stream.
+     * @param batch Records to write.
+     */
+    void write(const std::vector<Record>& batch);
+
+    /**
+     * @brief Body of the background writer thread.
+     */
+    void writerLoop();
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers; /**< Buffers of all logging threads. */
+    std::mutex buffersMutex;                            /**< Guards registration, not logging. */
+    std::atomic<uint64_t> nextSequence{0};              /**< Global record counter. */
+    std::atomic<uint64_t> dropped{0};                   /**< Records lost on full buffers. */
+    std::atomic<int> level;                             /**< Runtime minimal level. */
+    std::atomic<bool> running{true};                    /**< Whether the writer keeps running. */
+    std::mutex wakeMutex;                               /**< Used only by the writer to sleep. */
+    std::condition_variable wake;                       /**< Wakes the writer on shutdown. */
+    std::thread writer;                                 /**< Background writer thread. */
+};
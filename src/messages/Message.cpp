@@ -11,20 +11,103 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <cmath>
 #include <string>
 
+/**
+ * @brief Reads a JSON array of strings into a set.
+ * @param array The array to read.
+ * @return Set of the strings.
+ */
+static std::set<std::string> stringSetFromJson(const QJsonArray& array) {
+    std::set<std::string> result = {};
+    for (const QJsonValue& value : array) {
+        result.insert(value.toString().toStdString());
+    }
+    return result;
+}
+
+/**
+ * @brief Writes a set of strings as a JSON array.
+ * @param strings The strings to write.
+ * @return JSON array of the strings.
+ */
+static QJsonArray stringSetToJson(const std::set<std::string>& strings) {
+    QJsonArray array;
+    for (const std::string& str : strings) {
+        array.append(QString::fromStdString(str));
+    }
+    return array;
+}
+
+/** @brief Largest integer a JSON number (a double) holds exactly. */
+static constexpr int64_t MaxExactJsonInteger = int64_t(1) << 53;
+
+/**
+ * @brief Writes a typed value as a native JSON value.
+ * @param value The value to write.
+ * @return JSON number, bool or string.
+ */
+static QJsonValue typedValueToJson(const TypedValue& value) {
+    switch (value.type()) {
+        case EValueType::INT:
+            // Larger integers would be rounded by the double of a JSON number
+            if (value.toInt() >= -MaxExactJsonInteger && value.toInt() <= MaxExactJsonInteger) {
+                return QJsonValue(static_cast<qint64>(value.toInt()));
+            }
+            return QJsonValue(QString::fromStdString(value.toString()));
+        case EValueType::FLOAT:
+            return QJsonValue(value.toDouble());
+        case EValueType::BOOL:
+            return QJsonValue(value.toBool());
+        default:
+            return QJsonValue(QString::fromStdString(value.str()));
+    }
+}
+
+/**
+ * @brief Reads a typed value written by typedValueToJson().
+ * @param value The JSON value.
+ * @param typeName The type sent along, undefined from senders predating typed values.
+ * @return The typed value.
+ */
+static TypedValue typedValueFromJson(const QJsonValue& value, const QJsonValue& typeName) {
+    bool declared = typeName.isString();
+    EValueType type = valueTypeFromString(typeName.toString().toStdString());
+
+    if (value.isBool()) {
+        return TypedValue(value.toBool());
+    }
+    if (value.isDouble()) {
+        double real = value.toDouble();
+        bool whole = std::trunc(real) == real && std::fabs(real) <= static_cast<double>(MaxExactJsonInteger);
+        if (declared ? type == EValueType::INT && whole : whole) {
+            return TypedValue(static_cast<int64_t>(real));
+        }
+        return TypedValue(real);
+    }
+
+    std::string text = value.toString().toStdString();
+    if (declared) {
+        return TypedValue::parse(text, type);
+    }
+    // Untyped senders send every value as text
+    return TypedValue::infer(text);
+}
+
 Message::Message() {
     this->type = EMessageType::EMPTY;
     this->name = "";
     this->inputName = "";
-    this->inputValue = "";
-    this->timestamp = "";
+    this->inputValue = TypedValue();
+    this->time = EventTime();
     this->elementType = EItemType::STATE;
     this->currentElement = "";
     this->inputValues = {};
     this->outputValues = {};
     this->internalValues = {};
     this->otherData = {};
+    this->sessionId = "";
 }
 
 Message::Message(std::string receivedMessage) {
@@ -32,11 +115,12 @@ Message::Message(std::string receivedMessage) {
 
     QJsonObject root = receivedMessageDoc.object();
     this->type = messageTypeFromString(root["type"].toString().toStdString());
+    this->sessionId = root["sessionId"].toString().toStdString();
 
     switch (this->type) {
         case (EMessageType::INPUT): {
             std::string inputName = root["inputName"].toString().toStdString();
-            std::string inputValue = root["inputValue"].toString().toStdString();
+            TypedValue inputValue = typedValueFromJson(root["inputValue"], root["inputType"]);
             this->buildInputMessage(inputName, inputValue);
             break;
         }
@@ -62,8 +146,27 @@ Message::Message(std::string receivedMessage) {
             this->buildRejectMessage(otherInfo);
             break;
         }
+        case (EMessageType::SUBSCRIBE): {
+            Subscription subscription;
+            for (const QJsonValue& value : root["elementTypes"].toArray()) {
+                std::string typeStr = value.toString().toStdString();
+                if (typeStr == "STATE" || typeStr == "TRANSITION") {
+                    subscription.elementTypes.insert(elementTypeFromString(typeStr));
+                }
+            }
+            subscription.states = stringSetFromJson(root["states"].toArray());
+            subscription.transitions = stringSetFromJson(root["transitions"].toArray());
+            subscription.inputs = stringSetFromJson(root["inputs"].toArray());
+            subscription.outputs = stringSetFromJson(root["outputs"].toArray());
+            subscription.internals = stringSetFromJson(root["internals"].toArray());
+            this->buildSubscribeMessage(subscription);
+            break;
+        }
         case (EMessageType::LOG): {
-            std::string timestamp = root["timestamp"].toString().toStdString();
+            // Nanoseconds do not fit the double of a JSON number, they travel as decimal strings
+            EventTime time;
+            time.monotonicNs = root["monotonicNs"].toString().toLongLong();
+            time.clockOffsetNs = root["clockOffsetNs"].toString().toLongLong();
             std::string elementTypeStr = root["elementType"].toString().toStdString();
             EItemType elementType = elementTypeFromString(elementTypeStr);
             std::string currentElement = root["currentElement"].toString().toStdString();
@@ -94,7 +197,7 @@ Message::Message(std::string receivedMessage) {
                 internalValues[internalID] = internalVal;
             }
 
-            this->buildLogMessage(timestamp,
+            this->buildLogMessage(time,
                 elementType,
                 currentElement,
                 inputValues,
@@ -108,11 +211,15 @@ Message::Message(std::string receivedMessage) {
 std::string Message::toMessageString() const {
     QJsonObject msgDoc;
     msgDoc["type"] = QString::fromStdString(eMessageTypeToString(this->type));
+    if (!this->sessionId.empty()) {
+        msgDoc["sessionId"] = QString::fromStdString(this->sessionId);
+    }
     switch (this->type) {
 
         case (EMessageType::INPUT) : {
             msgDoc["inputName"] = QString::fromStdString(this->inputName);
-            msgDoc["inputValue"] = QString::fromStdString(this->inputValue);
+            msgDoc["inputValue"] = typedValueToJson(this->inputValue);
+            msgDoc["inputType"] = QString::fromStdString(eValueTypeToString(this->inputValue.type()));
             break;
         }
 
@@ -126,8 +233,23 @@ std::string Message::toMessageString() const {
             break;
         }
 
+        case (EMessageType::SUBSCRIBE) : {
+            QJsonArray typesArray;
+            for (EItemType elementType : this->subscription.elementTypes) {
+                typesArray.append(QString::fromStdString(eItemTypeToString(elementType)));
+            }
+            msgDoc["elementTypes"] = typesArray;
+            msgDoc["states"] = stringSetToJson(this->subscription.states);
+            msgDoc["transitions"] = stringSetToJson(this->subscription.transitions);
+            msgDoc["inputs"] = stringSetToJson(this->subscription.inputs);
+            msgDoc["outputs"] = stringSetToJson(this->subscription.outputs);
+            msgDoc["internals"] = stringSetToJson(this->subscription.internals);
+            break;
+        }
+
         case (EMessageType::LOG) : {
-            msgDoc["timestamp"] = QString::fromStdString(this->timestamp);
+            msgDoc["monotonicNs"] = QString::number(this->time.monotonicNs);
+            msgDoc["clockOffsetNs"] = QString::number(this->time.clockOffsetNs);
             msgDoc["elementType"] = QString::fromStdString(eItemTypeToString(this->elementType));
             msgDoc["currentElement"] = QString::fromStdString(this->currentElement);
 
@@ -172,7 +294,7 @@ std::string Message::toMessageString() const {
    return doc.toJson().toStdString();
 }
 
-void Message::buildInputMessage(const std::string& inputName, const std::string& inputValue) {
+void Message::buildInputMessage(const std::string& inputName, const TypedValue& inputValue) {
     this->type = EMessageType::INPUT;
     this->inputName = inputName;
     this->inputValue = inputValue;
@@ -199,14 +321,19 @@ void Message::buildRejectMessage(const std::string& otherInfo) {
 void Message::buildStopMessage() {
     this->type = EMessageType::STOP;
 }
-void Message::buildLogMessage(const std::string& timestamp,
+
+void Message::buildSubscribeMessage(const Subscription& subscription) {
+    this->type = EMessageType::SUBSCRIBE;
+    this->subscription = subscription;
+}
+void Message::buildLogMessage(const EventTime& time,
     EItemType elementType,
     const std::string& currentElement, 
     const std::map<std::string, std::string>& inputValues, 
     const std::map<std::string, std::string>& outputValues, 
     const std::map<std::string, std::string>& internalValues) {
         this->type = EMessageType::LOG;
-        this->timestamp = timestamp;
+        this->time = time;
         this->elementType = elementType;
         this->currentElement = currentElement;
         this->inputValues = inputValues;
@@ -226,6 +353,10 @@ std::string Message::getInputName() const {
     return this->inputName;
 }
 std::string Message::getInputValue() const {
+    return this->inputValue.toString();
+}
+
+const TypedValue& Message::getTypedInputValue() const {
     return this->inputValue;
 }
 
@@ -249,8 +380,32 @@ std::map<std::string, std::string> Message::getInputValues() const {
     return this->inputValues;
 }
 
+std::map<std::string, std::string> Message::getInternalValues() const {
+    return this->internalValues;
+}
+
+std::string Message::getTimestamp() const {
+    return SessionClock::format(this->time.wallNs());
+}
+
+const EventTime& Message::getEventTime() const {
+    return this->time;
+}
+
+const Subscription& Message::getSubscription() const {
+    return this->subscription;
+}
+
+void Message::setSessionId(const std::string& sessionId) {
+    this->sessionId = sessionId;
+}
+
+std::string Message::getSessionId() const {
+    return this->sessionId;
+}
+
 std::string Message::getLogString() const {
-    std::string log = "[" + this->timestamp + "] ";
+    std::string log = "[" + this->getTimestamp() + "] ";
     log += "Element: " + this->currentElement + " (" + eItemTypeToString(this->elementType) + ")\n";
 
     log += "Inputs:\n";
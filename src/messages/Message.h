@@ -14,6 +14,9 @@
 #include <QJsonValue>
 #include "../common/EMessageType.h"
 #include "../common/EItemType.h"
+#include "../common/TypedValue.h"
+#include "../common/SessionClock.h"
+#include "Subscription.h"
 #include <map>
 
 /**
@@ -31,11 +34,11 @@ private:
     /** @brief Name of the input signal. */
     std::string inputName;
 
-    /** @brief Value of the input signal. */
-    std::string inputValue;
+    /** @brief Value of the input signal in its native type. */
+    TypedValue inputValue;
 
-    /** @brief Timestamp for a log message. */
-    std::string timestamp;
+    /** @brief Time of the event of a log message, formatted only when displayed. */
+    EventTime time;
 
     /** @brief The type of the FSM element to activate. */
     EItemType elementType;
@@ -55,6 +58,12 @@ private:
     /** @brief Extra data needed for other messages */
     std::string otherData;
 
+    /** @brief Filter requested by a subscribe message. */
+    Subscription subscription;
+
+    /** @brief Session the message belongs to, empty for the default session. */
+    std::string sessionId;
+
 public:
     /**
      * @brief Constructs a Message from a raw string representation.
@@ -76,9 +85,9 @@ public:
     /**
      * @brief Constructs an input message with the given name and value.
      * @param inputName Name of the input.
-     * @param inputValue Value of the input.
+     * @param inputValue Value of the input, sent with its type.
      */
-    void buildInputMessage(const std::string& inputName, const std::string& inputValue);
+    void buildInputMessage(const std::string& inputName, const TypedValue& inputValue);
 
     /**
      * @brief Constructs a JSON message with the given name.
@@ -107,16 +116,22 @@ public:
      */
     void buildRequestMessage();
 
+    /**
+     * @brief Constructs a subscribe message selecting what the client receives.
+     * @param subscription The requested filter, an empty one subscribes to everything.
+     */
+    void buildSubscribeMessage(const Subscription& subscription);
+
     /**
      * @brief Constructs a log message with data
-     * @param timestamp Time of the event.
+     * @param time Time of the event.
      * @param elementType Type of the element involved.
      * @param currentElement Identifier of the element.
      * @param inputValues Key-value pairs of input values.
      * @param outputValues Key-value pairs of output values.
      * @param internalValues Key-value pairs of internal state values.
      */
-    void buildLogMessage(const std::string& timestamp,
+    void buildLogMessage(const EventTime& time,
                          EItemType elementType,
                          const std::string& currentElement,
                          const std::map<std::string, std::string>& inputValues,
@@ -143,10 +158,16 @@ public:
 
     /**
      * @brief Gets the value of the input.
-     * @return The input value.
+     * @return The input value as text.
      */
     std::string getInputValue() const;
 
+    /**
+     * @brief Gets the value of the input in its native type.
+     * @return The typed input value.
+     */
+    const TypedValue& getTypedInputValue() const;
+
     /**
      * @brief Gets the formatted log message string.
      * @return The log string.
@@ -177,6 +198,42 @@ public:
      */
     std::map<std::string, std::string> getInputValues() const;
 
+    /**
+     * @brief Gets a map of internal variable values.
+     * @return Internal values as key-value pairs.
+     */
+    std::map<std::string, std::string> getInternalValues() const;
+
+    /**
+     * @brief Gets the timestamp of a log message formatted in local time.
+     * @return The timestamp string.
+     */
+    std::string getTimestamp() const;
+
+    /**
+     * @brief Gets the time of the event of a log message.
+     * @return The monotonic stamp with its wall-clock offset.
+     */
+    const EventTime& getEventTime() const;
+
+    /**
+     * @brief Gets the filter of a subscribe message.
+     * @return The subscription.
+     */
+    const Subscription& getSubscription() const;
+
+    /**
+     * @brief Sets the session the message belongs to, kept by every build method.
+     * @param sessionId Id of the session, empty for the default session.
+     */
+    void setSessionId(const std::string& sessionId);
+
+    /**
+     * @brief Gets the session the message belongs to.
+     * @return Id of the session, empty for the default session.
+     */
+    std::string getSessionId() const;
+
     /**
      * @brief Gets additional information attached to the message.
      * @return The other data string.
@@ -0,0 +1,107 @@
+/**
+ * @file Subscription.cpp
+ * @brief Implementation file for the filter a monitoring client subscribes with
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "Subscription.h"
+#include "Message.h"
+
+/**
+ * @brief Keeps only the selected keys of a value map.
+ * @param values The map to filter.
+ * @param selected Keys to keep.
+ * @return The filtered map.
+ */
+static std::map<std::string, std::string> selectValues(const std::map<std::string, std::string>& values,
+                                                       const std::set<std::string>& selected) {
+    std::map<std::string, std::string> result = {};
+    for (const std::string& name : selected) {
+        auto it = values.find(name);
+        if (it != values.end()) {
+            result.insert(*it);
+        }
+    }
+    return result;
+}
+
+bool Subscription::isEmpty() const {
+    return this->elementTypes.empty() && this->states.empty() && this->transitions.empty() && !this->projects();
+}
+
+bool Subscription::projects() const {
+    return !this->inputs.empty() || !this->outputs.empty() || !this->internals.empty();
+}
+
+bool Subscription::matches(const Message& msg) const {
+    if (msg.getType() != EMessageType::LOG) {
+        return true;
+    }
+
+    EItemType type = msg.getElementType();
+    if (!this->elementTypes.empty() && this->elementTypes.count(type) == 0) {
+        return false;
+    }
+
+    // Naming only states (or only transitions) selects that element type
+    if (this->elementTypes.empty() && this->states.empty() != this->transitions.empty()) {
+        EItemType named = this->states.empty() ? EItemType::TRANSITION : EItemType::STATE;
+        if (type != named) {
+            return false;
+        }
+    }
+
+    const std::set<std::string>& elements = (type == EItemType::STATE) ? this->states : this->transitions;
+    return elements.empty() || elements.count(msg.getCurrentElement()) > 0;
+}
+
+bool Subscription::accept(const Message& msg) {
+    if (!this->matches(msg)) {
+        return false;
+    }
+    bool elementFilters = !this->elementTypes.empty() || !this->states.empty() || !this->transitions.empty();
+    if (msg.getType() != EMessageType::LOG || !this->projects() || elementFilters) {
+        return true;
+    }
+    return this->recordChanges(msg);
+}
+
+bool Subscription::recordChanges(const Message& msg) {
+    bool changed = false;
+    auto record = [this, &changed](const std::string& category,
+                                   const std::map<std::string, std::string>& values,
+                                   const std::set<std::string>& selected) {
+        for (const std::string& name : selected) {
+            auto it = values.find(name);
+            if (it == values.end()) {
+                continue;
+            }
+            auto [last, inserted] = this->lastSent.try_emplace(category + name, it->second);
+            if (inserted || last->second != it->second) {
+                last->second = it->second;
+                changed = true;
+            }
+        }
+    };
+    record("in:", msg.getInputValues(), this->inputs);
+    record("out:", msg.getOutputValues(), this->outputs);
+    record("var:", msg.getInternalValues(), this->internals);
+    return changed;
+}
+
+Message Subscription::project(const Message& msg) const {
+    if (msg.getType() != EMessageType::LOG || !this->projects()) {
+        return msg;
+    }
+
+    Message projected;
+    projected.buildLogMessage(msg.getEventTime(),
+        msg.getElementType(),
+        msg.getCurrentElement(),
+        selectValues(msg.getInputValues(), this->inputs),
+        selectValues(msg.getOutputValues(), this->outputs),
+        selectValues(msg.getInternalValues(), this->internals));
+    projected.setSessionId(msg.getSessionId());
+    return projected;
+}
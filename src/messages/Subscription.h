@@ -0,0 +1,97 @@
+/**
+ * @file Subscription.h
+ * @brief Header file for the filter a monitoring client subscribes with
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include "../common/EItemType.h"
+
+class Message;
+
+/**
+ * @class Subscription
+ * @brief Selects which LOG messages a client receives and which variables they carry.
+ *
+ * Empty sets do not filter: an empty subscription receives every message unchanged.
+ * Element filters (types, states, transitions) decide whether a LOG is sent at all.
+ * Naming only states or only transitions without element types also selects that element
+ * type, so a subscription to some states does not receive transition LOG messages.
+ * Variable filters (inputs, outputs, internals) project the LOG to the listed variables;
+ * once any of them is set, categories left empty are dropped from the message.
+ * A subscription with only variable filters receives a LOG only when one of its variables
+ * differs from the value last sent to it, so watching one output costs one message per change.
+ * Messages other than LOG always pass.
+ */
+class Subscription {
+public:
+    /** @brief Element types of the LOG messages to receive. */
+    std::set<EItemType> elementTypes;
+
+    /** @brief Names of the states whose entry is reported. */
+    std::set<std::string> states;
+
+    /** @brief Ids of the transitions whose firing is reported. */
+    std::set<std::string> transitions;
+
+    /** @brief Names of the inputs to keep in reported LOG messages. */
+    std::set<std::string> inputs;
+
+    /** @brief Names of the outputs to keep in reported LOG messages. */
+    std::set<std::string> outputs;
+
+    /** @brief Names of the internal variables to keep in reported LOG messages. */
+    std::set<std::string> internals;
+
+    /**
+     * @brief Checks whether the subscription filters nothing.
+     * @return True if every set is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Checks whether LOG messages are reduced to selected variables.
+     * @return True if any variable filter is set.
+     */
+    bool projects() const;
+
+    /**
+     * @brief Checks whether the message should be sent to the subscriber.
+     * @param msg The message to test.
+     * @return True if the message passes the element filters.
+     */
+    bool matches(const Message& msg) const;
+
+    /**
+     * @brief Checks whether the message should be sent and records the variables it sends.
+     *
+     * Same as matches(), except that a subscription with only variable filters also rejects
+     * LOG messages in which none of its variables changed since the last accepted one.
+     *
+     * @param msg The message to test.
+     * @return True if the message is to be sent to the subscriber.
+     */
+    bool accept(const Message& msg);
+
+    /**
+     * @brief Builds a copy of a LOG message with only the subscribed variables.
+     * @param msg The LOG message to project.
+     * @return The projected message, the message itself if nothing is projected.
+     */
+    Message project(const Message& msg) const;
+
+private:
+    /**
+     * @brief Records the subscribed variables of a LOG message.
+     * @param msg The LOG message.
+     * @return True if any of them is new or differs from the value last recorded.
+     */
+    bool recordChanges(const Message& msg);
+
+    /** @brief Values last sent for the subscribed variables, keyed by category and name. */
+    std::map<std::string, std::string> lastSent;
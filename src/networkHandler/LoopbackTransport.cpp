@@ -0,0 +1,196 @@
+/**
+ * @file LoopbackTransport.cpp
+ * @brief Implementation of the in-process loopback transport.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#include "LoopbackTransport.h"
+#include <thread>
+#include <vector>
+
+LoopbackHub& LoopbackHub::instance() {
+    static LoopbackHub hub;
+    return hub;
+}
+
+std::shared_ptr<LoopbackEndpoint> LoopbackHub::bind(int port) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = endpoints.find(port);
+    if (it != endpoints.end() && !it->second->pending.isClosed()) {
+        return nullptr;
+    }
+    auto endpoint = std::make_shared<LoopbackEndpoint>();
+    endpoints[port] = endpoint;
+    return endpoint;
+}
+
+void LoopbackHub::unbind(int port, const std::shared_ptr<LoopbackEndpoint>& endpoint) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = endpoints.find(port);
+    if (it != endpoints.end() && it->second == endpoint) {
+        endpoints.erase(it);
+    }
+}
+
+std::shared_ptr<LoopbackConnection> LoopbackHub::connect(int port) {
+    std::shared_ptr<LoopbackEndpoint> endpoint;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = endpoints.find(port);
+        if (it == endpoints.end()) {
+            return nullptr;
+        }
+        endpoint = it->second;
+    }
+
+    auto connection = std::make_shared<LoopbackConnection>();
+    connection->id = nextConnectionId.fetch_add(1);
+    if (!endpoint->pending.push(connection)) {
+        return nullptr;
+    }
+    return connection;
+}
+
+void LoopbackSender::setHostAndPort(const std::string&, int port) {
+    this->port = port;
+}
+
+bool LoopbackSender::connectToServer() {
+    if (std::atomic_load(&connection)) {
+        FSM_LOG_WARNING("Already connected. Close the current connection before reusing.");
+        return false;
+    }
+
+    auto created = LoopbackHub::instance().connect(port);
+    if (!created) {
+        FSM_LOG_WARNING("Connection failed!");
+        return false;
+    }
+
+    std::atomic_store(&connection, created);
+    FSM_LOG_INFO("Connected to loopback server: " + std::to_string(port));
+    return true;
+}
+
+bool LoopbackSender::sendMessage(const std::string& msg) {
+    auto active = std::atomic_load(&connection);
+    if (!active) {
+        FSM_LOG_ERROR("Not connected! Call connectToServer first.");
+        return false;
+    }
+
+    if (!active->toServer.push(msg)) {
+        FSM_LOG_ERROR("Send failed: connection closed.");
+        return false;
+    }
+    FSM_LOG_DEBUG("Message sent over loopback " + std::to_string(active->id) + ": " + msg);
+    return true;
+}
+
+std::string LoopbackSender::recvMessage() {
+    auto active = std::atomic_load(&connection);
+    if (!active) {
+        FSM_LOG_ERROR("Invalid connection, cannot receive data!");
+        return "";
+    }
+
+    std::string message;
+    if (!active->toClient.waitPop(message)) {
+        FSM_LOG_INFO("Connection closed by server.");
+        return "";
+    }
+    return message;
+}
+
+void LoopbackSender::closeConnection() {
+    auto active = std::atomic_exchange(&connection, std::shared_ptr<LoopbackConnection>());
+    if (active) {
+        FSM_LOG_INFO("Connection closed for loopback " + std::to_string(active->id));
+        active->toServer.close();
+        active->toClient.close();
+    }
+}
+
+void LoopbackListener::startListening(int port,
+    std::function<void(const std::string&, int)> onMessage,
+    std::function<void(int)> onDisconnect,
+    std::function<void(bool)> onReady) {
+
+    auto bound = LoopbackHub::instance().bind(port);
+    if (!bound) {
+        FSM_LOG_ERROR("bind: loopback port " + std::to_string(port) + " already in use");
+        if (onReady) {
+            onReady(false);
+        }
+        return;
+    }
+    std::atomic_store(&endpoint, bound);
+    FSM_LOG_INFO("Listening for loopback clients on port " + std::to_string(port) + "...");
+    if (onReady) {
+        onReady(true);
+    }
+
+    std::vector<std::thread> clientThreads;
+    std::shared_ptr<LoopbackConnection> accepted;
+
+    while (bound->pending.waitPop(accepted)) {
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections[accepted->id] = accepted;
+        }
+        FSM_LOG_INFO("Client connected! Loopback: " + std::to_string(accepted->id));
+
+        clientThreads.emplace_back([this, accepted, onMessage, onDisconnect]() {
+            std::string msg;
+            while (accepted->toServer.waitPop(msg)) {
+                FSM_LOG_DEBUG("Server: received message from loopback " + std::to_string(accepted->id) + ": " + msg);
+                try {
+                    onMessage(msg, accepted->id);
+                } catch (const std::exception& e) {
+                    FSM_LOG_ERROR(std::string("Error processing message: ") + e.what());
+                }
+            }
+
+            FSM_LOG_INFO("Client " + std::to_string(accepted->id) + " disconnected.");
+            accepted->toClient.close();
+            {
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connections.erase(accepted->id);
+            }
+            if (onDisconnect) {
+                onDisconnect(accepted->id);
+            }
+        });
+    }
+
+    LoopbackHub::instance().unbind(port, bound);
+    FSM_LOG_INFO("Server has stopped accepting clients.");
+
+    for (auto& t : clientThreads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    std::atomic_store(&endpoint, std::shared_ptr<LoopbackEndpoint>());
+}
+
+bool LoopbackListener::sendToClient(int clientSocket, const std::string& msg) {
+    std::shared_ptr<LoopbackConnection> target;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        auto it = connections.find(clientSocket);
+        if (it == connections.end()) {
+            return false;
+        }
+        target = it->second;
+    }
+    return target->toClient.push(msg);
+}
+
+void LoopbackListener::stopListening() {
+    auto bound = std::atomic_load(&endpoint);
+    if (bound) {
+        bound->pending.close();
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file LoopbackTransport.h
+ * @brief Header file for the in-process transport connecting GUI and interpreter without sockets.
+ *
+ * Each connection is a pair of lock-free queues, one for every direction. The listener and
+ * the senders meet in the LoopbackHub using the port number as the address.
+ *
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include "NetworkHandler.h"
+#include "MpscQueue.h"
+#include <map>
+
+/**
+ * @struct LoopbackConnection
+ * @brief Both directions of a single in-process connection.
+ */
+struct LoopbackConnection {
+    int id;                              /**< Client identifier passed to the listener callbacks. */
+    MpscQueue<std::string> toServer;     /**< Messages sent by the client. */
+    MpscQueue<std::string> toClient;     /**< Messages sent by the server. */
+};
+
+/**
+ * @struct LoopbackEndpoint
+ * @brief Listening side of a port, holds connections waiting to be accepted.
+ */
+struct LoopbackEndpoint {
+    MpscQueue<std::shared_ptr<LoopbackConnection>> pending; /**< Connections not yet accepted. */
+};
+
+/**
+ * @class LoopbackHub
+ * @brief Process-wide registry of listening loopback endpoints.
+ *
+ * The registry is locked only while connecting and binding, never on the data path.
+ */
+class LoopbackHub {
+public:
+    /**
+     * @brief Gets the process-wide hub.
+     * @return Reference to the hub.
+     */
+    static LoopbackHub& instance();
+
+    /**
+     * @brief Registers a listening endpoint for the port.
+     * @param port Port to bind.
+     * @return The endpoint, nullptr if the port is already bound.
+     */
+    std::shared_ptr<LoopbackEndpoint> bind(int port);
+
+    /**
+     * @brief Removes the endpoint of the port if it is still the registered one.
+     * @param port Port to unbind.
+     * @param endpoint Endpoint returned by bind().
+     */
+    void unbind(int port, const std::shared_ptr<LoopbackEndpoint>& endpoint);
+
+    /**
+     * @brief Creates a connection and queues it on the endpoint of the port.
+     * @param port Port to connect to.
+     * @return The connection, nullptr if nothing listens on the port.
+     */
+    std::shared_ptr<LoopbackConnection> connect(int port);
+
+private:
+    std::mutex registryMutex;                                     /**< Guards endpoints. */
+    std::map<int, std::shared_ptr<LoopbackEndpoint>> endpoints;   /**< Bound endpoints by port. */
+    std::atomic<int> nextConnectionId{1};                         /**< Counter of connection ids. */
+};
+
+/**
+ * @class LoopbackSender
+ * @brief Sends messages to a listener in the same process.
+ */
+class LoopbackSender : public NetworkSender {
+public:
+    bool sendMessage(const std::string& msg) override;
+    bool connectToServer() override;
+    std::string recvMessage() override;
+    void closeConnection() override;
+    void setHostAndPort(const std::string& host, int port) override;
+
+private:
+    std::shared_ptr<LoopbackConnection> connection; /**< Active connection, accessed atomically. */
+    int port = -1;                                  /**< Port of the listener. */
+};
+
+/**
+ * @class LoopbackListener
+ * @brief Accepts in-process connections and dispatches their messages.
+ */
+class LoopbackListener : public NetworkListener {
+public:
+    void startListening(int port,
+        std::function<void(const std::string&, int)> onMessage,
+        std::function<void(int)> onDisconnect = nullptr,
+        std::function<void(bool)> onReady = nullptr) override;
+
+    bool sendToClient(int clientSocket, const std::string& msg) override;
+    void stopListening() override;
+
+private:
+    std::shared_ptr<LoopbackEndpoint> endpoint;                      /**< Bound endpoint, accessed atomically. */
+    std::mutex connectionsMutex;                                     /**< Guards connections. */
+    std::map<int, std::shared_ptr<LoopbackConnection>> connections;  /**< Accepted connections by id. */
+};
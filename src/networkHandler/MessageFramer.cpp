@@ -0,0 +1,93 @@
+/**
+ * @file MessageFramer.cpp
+ * @brief Implementation of the MessageFramer class.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#include "MessageFramer.h"
+#include <cstring>
+#include <sys/socket.h>
+
+MessageFramer::MessageFramer(size_t capacity)
+    : buffer(capacity > 0 ? capacity : DefaultCapacity) {}
+
+void MessageFramer::makeRoom() {
+    if (readPos > 0) {
+        // Move the partial message to the front, only unconsumed bytes are copied
+        size_t remaining = writePos - readPos;
+        std::memmove(buffer.data(), buffer.data() + readPos, remaining);
+        scanPos -= readPos;
+        writePos = remaining;
+        readPos = 0;
+        return;
+    }
+
+    // A single message fills the whole buffer, it has to grow
+    buffer.resize(buffer.size() * 2);
+}
+
+ssize_t MessageFramer::fill(int fd) {
+    if (writePos == buffer.size()) {
+        makeRoom();
+    }
+
+    ssize_t bytesRead = recv(fd, buffer.data() + writePos, buffer.size() - writePos, 0);
+    if (bytesRead > 0) {
+        writePos += static_cast<size_t>(bytesRead);
+    }
+    return bytesRead;
+}
+
+bool MessageFramer::next(std::string_view& message) {
+    while (scanPos < writePos) {
+        const char* base = buffer.data();
+        const void* found = std::memchr(base + scanPos, '\r', writePos - scanPos);
+        if (!found) {
+            scanPos = writePos;
+            break;
+        }
+
+        size_t pos = static_cast<const char*>(found) - base;
+        if (pos + 1 >= writePos) {
+            // '\r' is the last received byte, check it again after the next fill
+            scanPos = pos;
+            break;
+        }
+
+        if (base[pos + 1] != '\n') {
+            scanPos = pos + 1;
+            continue;
+        }
+
+        message = std::string_view(base + readPos, pos - readPos);
+        framedBytes += pos + 2 - readPos;
+        ++framedMessages;
+        readPos = pos + 2;
+        scanPos = readPos;
+
+        if (readPos == writePos) {
+            // Everything consumed, wrap to the start without copying
+            readPos = writePos = scanPos = 0;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void MessageFramer::reset() {
+    readPos = writePos = scanPos = 0;
+}
+
+size_t MessageFramer::pending() const {
+    return writePos - readPos;
+}
+
+uint64_t MessageFramer::bytesFramed() const {
+    return framedBytes;
+}
+
+uint64_t MessageFramer::messagesFramed() const {
+    return framedMessages;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file MessageFramer.h
+ * @brief Header file for the stream framer splitting socket data into "\r\n" delimited messages.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @class MessageFramer
+ * @brief Reads a byte stream into a reusable buffer and yields complete messages as views.
+ *
+ * The buffer is used as a ring: data is appended at the write cursor and consumed at the read
+ * cursor. When the write cursor reaches the end, the unconsumed tail is moved to the front so
+ * every message stays contiguous. Each byte is scanned for the delimiter only once, so pipelined
+ * messages are framed in linear time.
+ */
+class MessageFramer {
+public:
+    /** @brief Default buffer capacity in bytes. */
+    static constexpr size_t DefaultCapacity = 64 * 1024;
+
+    /**
+     * @brief Constructs a framer with the given initial capacity.
+     * @param capacity Initial buffer size, grows only when a single message exceeds it.
+     */
+    explicit MessageFramer(size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Receives available data from the socket into the free part of the buffer.
+     * @param fd Socket descriptor to read from.
+     * @return Number of bytes read, 0 when the peer closed the connection, -1 on error.
+     */
+    ssize_t fill(int fd);
+
+    /**
+     * @brief Extracts the next complete message without copying it.
+     *
+     * The view points into the internal buffer and stays valid until the next call to fill().
+     *
+     * @param message Set to the message content without the delimiter.
+     * @return True if a complete message was available.
+     */
+    bool next(std::string_view& message);
+
+    /**
+     * @brief Drops all buffered data.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of buffered bytes not yet returned as messages.
+     * @return Pending byte count.
+     */
+    size_t pending() const;
+
+    /**
+     * @brief Gets the total number of bytes consumed as framed messages.
+     * @return Framed byte count including delimiters.
+     */
+    uint64_t bytesFramed() const;
+
+    /**
+     * @brief Gets the total number of messages returned by next().
+     * @return Framed message count.
+     */
+    uint64_t messagesFramed() const;
+
+private:
+    /**
+     * @brief Makes space at the write cursor by compacting or growing the buffer.
+     */
+    void makeRoom();
+
+    std::vector<char> buffer;       /**< Backing storage reused for the whole connection. */
+    size_t readPos = 0;             /**< Start of the first unconsumed byte. */
+    size_t writePos = 0;            /**< End of the received data. */
+    size_t scanPos = 0;             /**< First byte not yet searched for the delimiter. */
+    uint64_t framedBytes = 0;       /**< Statistics: bytes consumed as messages. */
+    uint64_t framedMessages = 0;    /**< Statistics: messages returned. */
+};
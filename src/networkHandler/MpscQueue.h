@@ -0,0 +1,156 @@
+/**
+ * @file MpscQueue.h
+ * @brief Header file for the lock-free multi-producer single-consumer queue.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Unbounded queue where any number of threads push and a single thread pops.
+ *
+ * Pushing is lock-free (one atomic exchange). The consumer spins briefly when the queue is
+ * empty and then sleeps; producers touch the mutex only when the consumer is asleep.
+ * Closing waits for pushes already past the closed check, so the consumer drains them too.
+ *
+ * @tparam T Type of the queued values.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head(new Node()), tail(head.load()) {}
+
+    ~MpscQueue() {
+        T ignored;
+        while (tryPop(ignored)) {}
+        delete tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Appends a value, may be called from any thread.
+     * @param value Value to move into the queue.
+     * @return False if the queue was already closed and the value was dropped.
+     */
+    bool push(T value) {
+        // Announced before the check, close() either is seen here or waits for this push
+        pushing.fetch_add(1, std::memory_order_seq_cst);
+        if (closed.load(std::memory_order_seq_cst)) {
+            pushing.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+        pushing.fetch_sub(1, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wakeUp.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest value without waiting, called only by the consumer.
+     * @param value Receives the value.
+     * @return False if the queue is empty.
+     */
+    bool tryPop(T& value) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest value, waiting until one is pushed or the queue is closed.
+     * @param value Receives the value.
+     * @return False if the queue was closed and is empty.
+     */
+    bool waitPop(T& value) {
+        constexpr int SpinCount = 64;
+
+        while (true) {
+            for (int i = 0; i < SpinCount; ++i) {
+                if (tryPop(value)) {
+                    return true;
+                }
+                std::this_thread::yield();
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (tryPop(value)) {
+                sleeping.store(false, std::memory_order_relaxed);
+                return true;
+            }
+            if (sealed.load(std::memory_order_acquire)) {
+                sleeping.store(false, std::memory_order_relaxed);
+                return tryPop(value);
+            }
+
+            wakeUp.wait(lock);
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Closes the queue, the consumer drains what is left and then stops waiting.
+     */
+    void close() {
+        closed.store(true, std::memory_order_seq_cst);
+        while (pushing.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sealed.store(true, std::memory_order_release);
+        wakeUp.notify_all();
+    }
+
+    /**
+     * @brief Checks whether the queue was closed.
+     * @return True if closed.
+     */
+    bool isClosed() const {
+        return closed.load(std::memory_order_acquire);
+    }
+
+private:
+    /**
+     * @brief Linked list node, the list always starts with an already consumed stub node.
+     */
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node*> head;            /**< Last pushed node, shared by producers. */
+    Node* tail;                         /**< Consumed stub node, owned by the consumer. */
+    std::atomic<bool> closed{false};    /**< Whether the queue accepts values. */
+    std::atomic<int> pushing{0};        /**< Pushes between the closed check and the enqueue. */
+    std::atomic<bool> sealed{false};    /**< Closed with no push in flight, nothing more can arrive. */
+    std::atomic<bool> sleeping{false};  /**< Whether the consumer waits on wakeUp. */
+    std::mutex sleepMutex;              /**< Used only when the consumer sleeps. */
+    std::condition_variable wakeUp;     /**< Signals a push or close to the consumer. */
+};
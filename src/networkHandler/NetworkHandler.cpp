@@ -6,26 +6,36 @@
  */
 
 #include "NetworkHandler.h"
+#include "LoopbackTransport.h"
 #include "../messages/Message.h"
 #include <memory>
+#include <algorithm>
+#include <chrono>
 #include "../controllers/fsmController/FsmController.h"
+#include "../controllers/fsmController/ActionPipeline.h"
 
-std::mutex coutMutex;
-std::mutex responseMutex;
-
-void safePrint(const std::string& msg) {
-    std::lock_guard<std::mutex> lock(coutMutex);
-    std::cout << msg << std::endl;
-}
 // NetworkHandler constructor
-NetworkHandler::NetworkHandler(const std::string& host, int port)
+NetworkHandler::NetworkHandler(const std::string& host, int port, ETransportType transport)
     : host(host), port(port) {
-    // Create instances of SimpleParser, TCPListener, and TCPSender
-    this->listener = std::unique_ptr<TCPListener>(new TCPListener());
-    this->sender = std::unique_ptr<TCPSender>(new TCPSender());
+    // Create the listener and sender of the configured transport
+    switch (transport) {
+        case ETransportType::UNIX:
+            this->listener = std::make_unique<UnixListener>();
+            this->sender = std::make_unique<UnixSender>();
+            break;
+        case ETransportType::LOOPBACK:
+            this->listener = std::make_unique<LoopbackListener>();
+            this->sender = std::make_unique<LoopbackSender>();
+            break;
+        case ETransportType::TCP:
+        default:
+            this->listener = std::make_unique<TCPListener>();
+            this->sender = std::make_unique<TCPSender>();
+            break;
+    }
     
     // Set the host and port for the sender
-    dynamic_cast<TCPSender*>(this->sender.get())->setHostAndPort(host, port);
+    this->sender->setHostAndPort(host, port);
 }
 
 // Connect to the server
@@ -43,6 +53,41 @@ std::string NetworkHandler::recvFromHost() {
     return "";
 }
 
+// Connect, retrying with exponential backoff until the deadline
+bool NetworkHandler::connectWithBackoff(int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    std::chrono::milliseconds delay(InitialBackoffMs);
+
+    while (true) {
+        if (connectToServer()) {
+            return true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            FSM_LOG_WARNING("Host " + host + ":" + std::to_string(port) + " did not accept a connection in time.");
+            return false;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(delay, deadline - now));
+        delay = std::min(delay * 2, std::chrono::milliseconds(MaxBackoffMs));
+    }
+}
+
+// Wait for the listener to be bound
+bool NetworkHandler::waitUntilReady(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(readyMutex);
+    readyChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() {
+        return listenerState != ListenerState::PENDING;
+    });
+    return listenerState == ListenerState::READY;
+}
+
+// Stop the listener started by listen()
+void NetworkHandler::stopListening() {
+    if (listener) {
+        listener->stopListening();
+    }
+}
+
 // Close the connection
 void NetworkHandler::closeConnection() {
     if (sender) {
@@ -58,52 +103,90 @@ void NetworkHandler::sendToHost(const std::string& msg) {
 }
 
 // Listen for incoming messages
-void NetworkHandler::listen(int port) {
+void NetworkHandler::listen(int port, std::function<void(bool)> onReady) {
+    // Publishes readiness to waitUntilReady() and the caller
+    auto setState = [this](ListenerState state) {
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            listenerState = state;
+        }
+        readyChanged.notify_all();
+    };
+    setState(ListenerState::PENDING);
+
     if (listener) {
-        FsmController controller;
-        // Use a shared mutex to protect connectedClients
-     // List to track client sockets
+        // Messages of the session FSMs, handed over without a connection back to this listener;
+        // shared because a stopping FSM may still send its STOP after listen() returned
+        auto published = std::make_shared<MpscQueue<Message>>();
+        FsmController controller([published](const Message& message) {
+            published->push(message);
+        });
+
+        // Runs on the thread of the QCoreApplication, the FSM is only touched from there
+        ActionPipeline pipeline([this, &controller](Message& message, int) {
+            // A STOP message stops the FSM of its session inside the controller
+            Message processed = controller.performAction(message);
+            broadcast(processed);
+
+            // The server stops accepting new clients once the last session is stopped
+            if (message.getType() == EMessageType::STOP && controller.sessionCount() == 0) {
+                FSM_LOG_INFO("STOP message received.");
+                listener->stopListening();
+            }
+        });
 
-        listener->startListening(port, [this, &controller](const std::string& msg, int clientSocket) {
+        // Sends the LOG messages off the FSM thread, so a slow client never stalls the FSMs
+        std::thread publisher([this, published, &pipeline]() {
+            Message message;
+            while (published->waitPop(message)) {
+                if (message.getType() == EMessageType::LOG) {
+                    broadcast(message);
+                } else {
+                    pipeline.submit(std::move(message), -1);
+                }
+            }
+        });
+
+        // Runs on the thread of the client, decodes the message and hands it over
+        listener->startListening(port, [this, &pipeline](const std::string& msg, int clientSocket) {
             {
                 // Lock the mutex to safely modify the list of connected clients
                 std::lock_guard<std::mutex> lock(socketMutex);
-                connectedClients.push_back(clientSocket);  // Add the new client socket
-                safePrint("Server: registered client: " + std::to_string(clientSocket));
+                if (std::find(connectedClients.begin(), connectedClients.end(), clientSocket) == connectedClients.end()) {
+                    connectedClients.push_back(clientSocket);  // Add the new client socket
+                    FSM_LOG_DEBUG("Server: registered client: " + std::to_string(clientSocket));
+                }
             }
 
-            // Process the incoming message
+            // Process the incoming message, the client receives the broadcasts of its session
             Message message(msg);
-            Message processed = controller.performAction(message);
-            std::string responseStr = processed.toMessageString() + "\r\n";
-            
-            // Send the response to all connected clients
             {
-                // Lock the mutex to ensure thread-safety while modifying the list of clients
                 std::lock_guard<std::mutex> lock(socketMutex);
-                std::vector<int> failedSockets;  // To store clients that failed to receive the message
-
-                // Send response to all connected clients
-                for (int targetSocket : connectedClients) {
-                    int result = ::send(targetSocket, responseStr.c_str(), responseStr.size(), 0);
-                    if (result <= 0) {
-                        safePrint("Failed to send to client " + std::to_string(targetSocket));
-                        failedSockets.push_back(targetSocket);  // Mark this socket for removal
-                    }
-                }
+                clientSessions[clientSocket] = message.getSessionId();
+            }
 
-                // Remove clients that failed to receive the message
-                for (int failedSocket : failedSockets) {
-                    connectedClients.erase(std::remove(connectedClients.begin(), connectedClients.end(), failedSocket), connectedClients.end());
-                    safePrint("Removed client " + std::to_string(failedSocket) + " due to send failure.");
+            // A subscription only changes what this client receives, the FSM is not involved
+            if (message.getType() == EMessageType::SUBSCRIBE) {
+                std::lock_guard<std::mutex> lock(socketMutex);
+                if (message.getSubscription().isEmpty()) {
+                    subscriptions.erase(clientSocket);
+                } else {
+                    subscriptions[clientSocket] = message.getSubscription();
                 }
+                Message accept;
+                accept.buildAcceptMessage();
+                listener->sendToClient(clientSocket, accept.toMessageString());
+                FSM_LOG_DEBUG("Server: updated subscription of client " + std::to_string(clientSocket));
+                return;
             }
 
-            // If the message type is STOP, stop the FSM
-            Message isStop(responseStr);
-            if (isStop.getType() == EMessageType::STOP) {
-                controller.getFsm()->stop();
+            // LOG messages are only forwarded, so they skip the hop to the FSM thread
+            if (message.getType() == EMessageType::LOG) {
+                broadcast(message);
+                return;
             }
+
+            pipeline.submit(std::move(message), clientSocket);
         },
         // Optional onDisconnect callback
         [this](int clientSocket) {
@@ -112,11 +195,72 @@ void NetworkHandler::listen(int port) {
             auto it = std::find(connectedClients.begin(), connectedClients.end(), clientSocket);
             if (it != connectedClients.end()) {
                 connectedClients.erase(it); 
-                safePrint("Server: Client " + std::to_string(clientSocket) + " removed.");
+                subscriptions.erase(clientSocket);
+                clientSessions.erase(clientSocket);
+                FSM_LOG_INFO("Server: Client " + std::to_string(clientSocket) + " removed.");
+            }
+        },
+        // Bound or failed, before the first client is accepted
+        [&setState, &onReady](bool bound) {
+            setState(bound ? ListenerState::READY : ListenerState::FAILED);
+            if (onReady) {
+                onReady(bound);
             }
         });
+
+        pipeline.close();
+        published->close();
+        publisher.join();
+    } else {
+        setState(ListenerState::FAILED);
+        if (onReady) {
+            onReady(false);
+        }
+    }
+
+    // A stopped listener is not ready for the next waiter, a failure is kept until the next listen()
+    std::lock_guard<std::mutex> lock(readyMutex);
+    if (listenerState == ListenerState::READY) {
+        listenerState = ListenerState::PENDING;
     }
 }
 
+// Send a response to all connected clients
+void NetworkHandler::broadcast(const Message& processed) {
+    std::string responseStr = processed.toMessageString();
 
+    // Lock the mutex to ensure thread-safety while modifying the list of clients
+    std::lock_guard<std::mutex> lock(socketMutex);
+    std::vector<int> failedSockets;  // To store clients that failed to receive the message
 
+    // Send response to all connected clients of its session, filtered by their subscriptions
+    for (int targetSocket : connectedClients) {
+        // Clients that have not sent a message yet belong to the default session
+        auto session = clientSessions.find(targetSocket);
+        std::string clientSession = session == clientSessions.end() ? std::string() : session->second;
+        if (clientSession != processed.getSessionId()) {
+            continue;
+        }
+        auto subscribed = subscriptions.find(targetSocket);
+        bool sent = true;
+        if (subscribed == subscriptions.end()) {
+            sent = listener->sendToClient(targetSocket, responseStr);
+        } else if (subscribed->second.accept(processed)) {
+            sent = subscribed->second.projects()
+                ? listener->sendToClient(targetSocket, subscribed->second.project(processed).toMessageString())
+                : listener->sendToClient(targetSocket, responseStr);
+        }
+        if (!sent) {
+            FSM_LOG_WARNING("Failed to send to client " + std::to_string(targetSocket));
+            failedSockets.push_back(targetSocket);  // Mark this socket for removal
+        }
+    }
+
+    // Remove clients that failed to receive the message
+    for (int failedSocket : failedSockets) {
+        connectedClients.erase(std::remove(connectedClients.begin(), connectedClients.end(), failedSocket), connectedClients.end());
+        subscriptions.erase(failedSocket);
+        clientSessions.erase(failedSocket);
+        FSM_LOG_INFO("Removed client " + std::to_string(failedSocket) + " due to send failure.");
+    }
+}
@@ -2,8 +2,9 @@
  * @file NetworkHandler.h
  * @brief Header file for networking aspects of the FSM tool project.
  * 
- * Defines abstract interfaces and concrete classes for TCP communication,
- * including sending, receiving, and listening to messages from remote clients or servers.
+ * Defines abstract interfaces and concrete classes for TCP and UNIX domain socket
+ * communication, including sending, receiving, and listening to messages from remote
+ * clients or servers. The in-process transport is declared in LoopbackTransport.h.
  * 
  * @author xlesigm00
  * @date 05.05.2025
@@ -19,10 +20,19 @@
 #include <sys/socket.h>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
+#include <memory>
+#include <vector>
+#include <map>
+#include "MessageFramer.h"
+#include "MpscQueue.h"
+#include "../logger/Logger.h"
+#include "../common/ETransportType.h"
+#include "../messages/Subscription.h"
 
 /**
  * @class NetworkParser
@@ -73,6 +83,14 @@ public:
      */
     virtual void closeConnection() = 0;
 
+    /**
+     * @brief Set the address of the server.
+     * 
+     * @param host IP or hostname, ignored by local transports.
+     * @param port Port number, identifies the server for every transport.
+     */
+    virtual void setHostAndPort(const std::string& host, int port) = 0;
+
     virtual ~NetworkSender() = default;
 };
 
@@ -88,10 +106,27 @@ public:
      * @param port Port number.
      * @param onMessage Callback for incoming messages (message, clientSocket).
      * @param onDisconnect Optional callback when a client disconnects.
+     * @param onReady Optional callback told whether the listener was bound, called once
+     *        before any client is accepted.
      */
     virtual void startListening(int port,
         std::function<void(const std::string&, int)> onMessage,
-        std::function<void(int)> onDisconnect = nullptr) = 0;
+        std::function<void(int)> onDisconnect = nullptr,
+        std::function<void(bool)> onReady = nullptr) = 0;
+
+    /**
+     * @brief Send a single message to a connected client.
+     * 
+     * @param clientSocket Client identifier passed to the onMessage callback.
+     * @param msg The message without the delimiter.
+     * @return True if the message was sent successfully, false otherwise.
+     */
+    virtual bool sendToClient(int clientSocket, const std::string& msg) = 0;
+
+    /**
+     * @brief Stop accepting new clients, startListening returns after current clients disconnect.
+     */
+    virtual void stopListening() = 0;
 
     virtual ~NetworkListener() = default;
 };
@@ -107,8 +142,10 @@ public:
      * 
      * @param host Hostname or IP address to connect/listen to.
      * @param port Port number for communication.
+     * @param transport Transport to use, taken from FSMCRAFT_TRANSPORT by default.
      */
-    NetworkHandler(const std::string& host, int port);
+    NetworkHandler(const std::string& host, int port,
+        ETransportType transport = transportTypeFromEnvironment());
 
     /**
      * @brief Send a message to the connected host.
@@ -117,12 +154,32 @@ public:
      */
     void sendToHost(const std::string& msg);
 
+    static constexpr int InitialBackoffMs = 1;     ///< First delay between connection attempts.
+    static constexpr int MaxBackoffMs = 100;       ///< Longest delay between connection attempts.
+
     /**
      * @brief Start listening for incoming client connections and handle communication.
      * 
+     * Returns when the listener is stopped.
+     * 
      * @param port Port number on which to listen.
+     * @param onReady Optional callback told whether the listener was bound, called on the
+     *        listening thread as soon as clients can connect.
+     */
+    void listen(int port, std::function<void(bool)> onReady = nullptr);
+
+    /**
+     * @brief Block until the listener started by listen() is bound.
+     * 
+     * @param timeoutMs Longest time to wait.
+     * @return True if clients can connect, false on timeout or when binding failed.
      */
-    void listen(int port);
+    bool waitUntilReady(int timeoutMs);
+
+    /**
+     * @brief Stop accepting clients, listen() returns once the connected clients are gone.
+     */
+    void stopListening();
 
     /**
      * @brief Receive a message from the connected host.
@@ -138,47 +195,146 @@ public:
      */
     bool connectToServer();
 
+    /**
+     * @brief Connect to the remote host, retrying with exponential backoff.
+     * 
+     * Attempts start InitialBackoffMs apart and the delay doubles up to MaxBackoffMs, so a
+     * server that is just starting is reached a few milliseconds after it is bound.
+     * 
+     * @param timeoutMs Time after which no further attempt is made.
+     * @return True on success, false if the host did not accept a connection in time.
+     */
+    bool connectWithBackoff(int timeoutMs);
+
     /**
      * @brief Close the current network connection.
      */
     void closeConnection();
 
 private:
+    /**
+     * @brief Send a response to every connected client, filtered by its subscription.
+     * 
+     * @param processed The response to send.
+     */
+    void broadcast(const Message& processed);
+
     std::unique_ptr<NetworkSender> sender;       /**< Object responsible for sending messages. */
     std::unique_ptr<NetworkListener> listener;   /**< Object responsible for listening to messages. */
     std::atomic<int> firstClientSocket{-1};      /**< Socket of the first connected client. */
     std::vector<int> connectedClients;           /**< Vector of connected client sockets. */
+    std::map<int, Subscription> subscriptions;   /**< Filters of the clients that sent SUBSCRIBE, guarded by socketMutex. */
+    std::map<int, std::string> clientSessions;   /**< Session of the last message of every client, guarded by socketMutex. */
     std::mutex socketMutex;                      /**< Mutex for thread-safe access to sockets. */
     std::mutex sockMutex2;                       /**< Secondary mutex for socket-related operations. */
+
+    /**
+     * @enum ListenerState
+     * @brief Readiness of the listener started by listen().
+     */
+    enum class ListenerState {
+        PENDING,    ///< Not started, not bound yet, or stopped.
+        READY,      ///< Bound, clients can connect.
+        FAILED      ///< Binding failed.
+    };
+
+    ListenerState listenerState = ListenerState::PENDING;   /**< Guarded by readyMutex. */
+    std::mutex readyMutex;                       /**< Guards listenerState. */
+    std::condition_variable readyChanged;        /**< Signalled when listenerState changes. */
     std::string host;                            /**< Target host name or IP address. */
     int port;                                    /**< Target port number. */
 };
 
 /**
- * @class TCPSender
- * @brief Sends messages to a server using the TCP protocol.
+ * @class StreamSender
+ * @brief Sends messages to a server over a connected stream socket.
+ *
+ * sendMessage() only pushes the message onto the per-connection queue. A writer thread owned
+ * by the connection drains whatever is queued and sends it with one sendmsg() call, the
+ * delimiters are added as separate iovecs, so producers never contend on a lock or a syscall.
  */
-class TCPSender : public NetworkSender {
+class StreamSender : public NetworkSender {
 public:
+    static constexpr size_t MaxBatch = 256;   ///< Messages gathered into one sendmsg() call.
+    static constexpr int CloseTimeoutMs = 1000; ///< Time the writer gets to send what is queued when closing.
+
+    /**
+     * @brief Sends the messages still queued and closes the connection.
+     */
+    ~StreamSender() override;
+
     bool sendMessage(const std::string& msg) override;
     bool connectToServer() override;
     std::string recvMessage() override;
     void closeConnection() override;
+    void setHostAndPort(const std::string& host, int port) override;
 
+protected:
     /**
-     * @brief Set the host and port for outgoing connections.
+     * @brief Create a socket and connect it to the server.
      * 
-     * @param host IP or hostname.
-     * @param port Port number.
+     * @return Connected socket descriptor, -1 on failure.
      */
-    void setHostAndPort(const std::string& host, int port);
+    virtual int openSocket() = 0;
 
-private:
-    int sock = -1;                    /**< Socket descriptor. */
-    sockaddr_in server;              /**< Server socket address. */
     std::string host;                /**< Server hostname/IP. */
-    std::string recvBuffer;          /**< Buffer for incoming data. */
     int port;                        /**< Server port. */
+
+private:
+    /**
+     * @struct Outbound
+     * @brief A queued message tagged with the connection it was sent on.
+     */
+    struct Outbound {
+        std::string payload;         /**< Message without delimiter. */
+        uint64_t connection = 0;     /**< Connection the message belongs to. */
+        bool last = false;           /**< Marks the end of the connection, the writer stops at it. */
+    };
+
+    /**
+     * @brief Sends queued messages of the connection in batches until it is closed.
+     * @param fd Socket of the connection.
+     * @param id Number of the connection, messages of other connections are dropped.
+     */
+    void writeLoop(int fd, uint64_t id);
+
+    /**
+     * @brief Stops the writer, closes the socket, expects connectionMutex held.
+     * 
+     * The writer gets CloseTimeoutMs to send the queued messages. A peer that stopped
+     * reading cannot hold the caller longer, the socket is shut down to end the send.
+     */
+    void releaseConnection();
+
+    std::atomic<int> sock{-1};               /**< Socket descriptor. */
+    std::atomic<bool> writable{false};       /**< Whether messages are accepted for the connection. */
+    std::atomic<uint64_t> connection{0};     /**< Number of the current connection. */
+    MpscQueue<Outbound> outbound;            /**< Messages waiting for the writer. */
+    std::thread writer;                      /**< Writer of the current connection. */
+    bool writerExited = false;               /**< Whether writeLoop() returned, guarded by writerMutex. */
+    std::mutex writerMutex;                  /**< Guards writerExited. */
+    std::condition_variable writerDone;      /**< Signalled when writeLoop() returns. */
+    std::mutex connectionMutex;              /**< Serializes connecting and closing. */
+    std::mutex readMutex;                    /**< Serializes readers of the framer. */
+    MessageFramer framer;                    /**< Frames incoming data into messages. */
+};
+
+/**
+ * @class TCPSender
+ * @brief Sends messages to a server using the TCP protocol.
+ */
+class TCPSender : public StreamSender {
+protected:
+    int openSocket() override;
+};
+
+/**
+ * @class UnixSender
+ * @brief Sends messages to a local server over a UNIX domain socket.
+ */
+class UnixSender : public StreamSender {
+protected:
+    int openSocket() override;
 };
 
 /**
@@ -197,31 +353,81 @@ public:
 };
 
 /**
- * @class TCPListener
- * @brief Listens for incoming TCP connections and messages.
+ * @class StreamListener
+ * @brief Listens for incoming stream socket connections and messages.
  */
-class TCPListener : public NetworkListener {
+class StreamListener : public NetworkListener {
 public:
     /**
-     * @brief Starts the TCP listener on the given port.
+     * @brief Starts the listener on the given port.
      * 
      * @param port Port to listen on.
      * @param onMessage Callback for incoming messages.
      * @param onDisconnect Callback when a client disconnects.
+     * @param onReady Callback told whether the socket was bound.
      */
     void startListening(int port,
         std::function<void(const std::string&, int)> onMessage,
-        std::function<void(int)> onDisconnect = nullptr) override;
+        std::function<void(int)> onDisconnect = nullptr,
+        std::function<void(bool)> onReady = nullptr) override;
+
+    bool sendToClient(int clientSocket, const std::string& msg) override;
+    void stopListening() override;
+
+protected:
+    /**
+     * @brief Create, bind and listen on the server socket.
+     * 
+     * @param port Port to listen on.
+     * @return Listening socket descriptor, -1 on failure.
+     */
+    virtual int openServerSocket(int port) = 0;
+
+    /**
+     * @brief Connect to the own server socket and close it right away to unblock accept().
+     * 
+     * @param port Port the listener is bound to.
+     */
+    virtual void connectToSelf(int port) = 0;
+
+    /**
+     * @brief Release resources of the server socket after it is closed.
+     * 
+     * @param port Port the listener was bound to.
+     */
+    virtual void cleanupServerSocket(int port);
+
+private:
+    std::atomic<bool> stopReceived{false};  /**< Flag indicating if the server should stop. */
+    int listeningPort = -1;                 /**< Port of the running listener, guarded by listenerMutex. */
+    std::mutex listenerMutex;               /**< Orders stopListening() against binding and releasing the port. */
 };
 
 /**
- * @brief Global mutex for thread-safe console output.
+ * @class TCPListener
+ * @brief Listens for incoming TCP connections and messages.
  */
-extern std::mutex coutMutex;
+class TCPListener : public StreamListener {
+protected:
+    int openServerSocket(int port) override;
+    void connectToSelf(int port) override;
+};
+
+/**
+ * @class UnixListener
+ * @brief Listens for local connections on a UNIX domain socket.
+ */
+class UnixListener : public StreamListener {
+protected:
+    int openServerSocket(int port) override;
+    void connectToSelf(int port) override;
+    void cleanupServerSocket(int port) override;
+};
 
 /**
- * @brief Utility function for printing to console in a thread-safe way.
+ * @brief Path of the UNIX domain socket used for the given port.
  * 
- * @param msg The message to be printed.
+ * @param port Port number identifying the server.
+ * @return Filesystem path of the socket.
  */
-void safePrint(const std::string& msg);
+std::string unixSocketPath(int port);
@@ -0,0 +1,263 @@
+/**
+ * @file ShmLogRing.cpp
+ * @brief Implementation of the shared-memory LOG ring and its readers.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#include "ShmLogRing.h"
+#include "../logger/Logger.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Rounds the value up to the next power of two.
+ * @param value Value to round, at least 1.
+ * @return The power of two.
+ */
+static uint32_t roundUpToPowerOfTwo(uint32_t value) {
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+ShmLogRing::ShmLogRing(const std::string& name, uint32_t slotCount, uint32_t slotSize)
+    : name(name) {
+    slotCount = roundUpToPowerOfTwo(slotCount == 0 ? 1 : slotCount);
+    if (slotSize < sizeof(ShmLogSlot) + 8) {
+        slotSize = sizeof(ShmLogSlot) + 8;
+    }
+    slotSize = (slotSize + 7) & ~7u;
+
+    // Truncating a segment readers still map would fault them, a fresh segment replaces it
+    if (shm_unlink(name.c_str()) == 0) {
+        FSM_LOG_INFO("Replaced the previous shared memory " + name);
+    }
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        FSM_LOG_ERROR("shm_open " + name + ": " + strerror(errno));
+        return;
+    }
+
+    size_t size = sizeof(ShmLogHeader) + static_cast<size_t>(slotCount) * slotSize;
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        FSM_LOG_ERROR("ftruncate " + name + ": " + strerror(errno));
+        close(fd);
+        shm_unlink(name.c_str());
+        return;
+    }
+
+    struct stat created{};
+    if (fstat(fd, &created) == 0) {
+        device = created.st_dev;
+        inode = created.st_ino;
+    }
+
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        FSM_LOG_ERROR("mmap " + name + ": " + strerror(errno));
+        shm_unlink(name.c_str());
+        return;
+    }
+
+    // The segment is zero-filled by ftruncate, so every slot starts with sequence 0 (empty)
+    mapping = mapped;
+    mappingSize = size;
+    header = new (mapped) ShmLogHeader();
+    slots = static_cast<char*>(mapped) + sizeof(ShmLogHeader);
+    slotMask = slotCount - 1;
+    this->slotSize = slotSize;
+
+    header->version = Version;
+    header->slotCount = slotCount;
+    header->slotSize = slotSize;
+    header->writeSeq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = Magic;
+
+    FSM_LOG_INFO("Publishing LOG messages to shared memory " + name);
+}
+
+ShmLogRing::~ShmLogRing() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        // A newer ring may have replaced the segment under the same name already
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd >= 0) {
+            struct stat current{};
+            bool own = fstat(fd, &current) == 0 && current.st_dev == device && current.st_ino == inode;
+            close(fd);
+            if (own) {
+                shm_unlink(name.c_str());
+            }
+        }
+    }
+}
+
+bool ShmLogRing::isOpen() const {
+    return header != nullptr;
+}
+
+bool ShmLogRing::publish(const std::string& msg) {
+    if (!header) {
+        return false;
+    }
+    // An oversized message still takes its sequence number, so readers see the gap
+    bool fits = msg.size() <= slotSize - sizeof(ShmLogSlot);
+    if (!fits) {
+        oversized.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t seq = nextSeq++;
+    ShmLogSlot* slot = reinterpret_cast<ShmLogSlot*>(slots + (seq & slotMask) * slotSize);
+
+    // Odd sequence marks the slot as being written, readers copying it now will retry
+    slot->seq.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->length = fits ? static_cast<uint32_t>(msg.size()) : 0;
+    slot->flags = fits ? 0 : ShmLogSlot::Dropped;
+    if (fits) {
+        std::memcpy(reinterpret_cast<char*>(slot) + sizeof(ShmLogSlot), msg.data(), msg.size());
+    }
+
+    slot->seq.store(2 * seq + 2, std::memory_order_release);
+    header->writeSeq.store(seq + 1, std::memory_order_release);
+    return fits;
+}
+
+uint64_t ShmLogRing::oversizedCount() const {
+    return oversized.load(std::memory_order_relaxed);
+}
+
+std::string ShmLogRing::nameFromEnvironment() {
+    const char* configured = std::getenv("FSMCRAFT_SHM_LOG");
+    return configured ? configured : "";
+}
+
+ShmLogReader::~ShmLogReader() {
+    detach();
+}
+
+bool ShmLogReader::attach(const std::string& name, bool fromOldest) {
+    detach();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        FSM_LOG_WARNING("shm_open " + name + ": " + strerror(errno));
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(ShmLogHeader)) {
+        FSM_LOG_WARNING("Shared memory " + name + " is not initialized.");
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        FSM_LOG_WARNING("mmap " + name + ": " + strerror(errno));
+        return false;
+    }
+
+    const ShmLogHeader* attached = static_cast<const ShmLogHeader*>(mapped);
+    uint32_t magic = attached->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (magic != ShmLogRing::Magic || attached->version != ShmLogRing::Version ||
+        size < sizeof(ShmLogHeader) + static_cast<size_t>(attached->slotCount) * attached->slotSize) {
+        FSM_LOG_WARNING("Shared memory " + name + " has an unknown layout.");
+        munmap(mapped, size);
+        return false;
+    }
+
+    mapping = mapped;
+    mappingSize = size;
+    header = attached;
+    slots = static_cast<const char*>(mapped) + sizeof(ShmLogHeader);
+    slotCount = attached->slotCount;
+    slotSize = attached->slotSize;
+
+    uint64_t written = header->writeSeq.load(std::memory_order_acquire);
+    nextSeq = (fromOldest && written > slotCount) ? written - slotCount : (fromOldest ? 0 : written);
+    return true;
+}
+
+void ShmLogReader::detach() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    header = nullptr;
+    slots = nullptr;
+}
+
+const ShmLogSlot* ShmLogReader::slotFor(uint64_t seq) const {
+    return reinterpret_cast<const ShmLogSlot*>(slots + (seq & (slotCount - 1)) * slotSize);
+}
+
+ShmLogReader::PollResult ShmLogReader::poll(std::string& msg, uint64_t& lost) {
+    if (!header) {
+        return PollResult::EMPTY;
+    }
+
+    uint64_t written = header->writeSeq.load(std::memory_order_acquire);
+    if (written < nextSeq) {
+        // The publisher recreated the segment, continue with its new messages
+        nextSeq = written;
+        return PollResult::EMPTY;
+    }
+    if (nextSeq == written) {
+        return PollResult::EMPTY;
+    }
+    if (written - nextSeq > slotCount) {
+        lost = written - slotCount - nextSeq;
+        nextSeq += lost;
+        return PollResult::OVERRUN;
+    }
+
+    const ShmLogSlot* slot = slotFor(nextSeq);
+    uint64_t expected = 2 * nextSeq + 2;
+    uint64_t before = slot->seq.load(std::memory_order_acquire);
+    if (before == expected) {
+        uint32_t flags = slot->flags;
+        uint32_t length = slot->length;
+        if (length > slotSize - sizeof(ShmLogSlot)) {
+            length = 0;
+        }
+        msg.assign(reinterpret_cast<const char*>(slot) + sizeof(ShmLogSlot), length);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == before) {
+            ++nextSeq;
+            if (flags & ShmLogSlot::Dropped) {
+                msg.clear();
+                lost = 1;
+                return PollResult::DROPPED;
+            }
+            return PollResult::OK;
+        }
+    }
+
+    // The slot was reused while reading, skip everything the publisher already overwrote
+    written = header->writeSeq.load(std::memory_order_acquire);
+    uint64_t oldest = written + 1 > slotCount ? written + 1 - slotCount : 0;
+    lost = oldest > nextSeq ? oldest - nextSeq : 1;
+    nextSeq += lost;
+    return PollResult::OVERRUN;
+}
+
+uint64_t ShmLogReader::position() const {
+    return nextSeq;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file ShmLogRing.h
+ * @brief Header file for the shared-memory ring streaming LOG messages to local monitors.
+ *
+ * The interpreter is the only writer. Any number of readers attach to the POSIX shared memory
+ * segment by name and read without system calls. Every slot is guarded by its own sequence
+ * number (a seqlock), so a reader that falls behind detects that its slots were overwritten
+ * and reports how many messages it lost instead of reading torn data. A message too large for
+ * a slot still takes its sequence number, its slot is marked as dropped and readers report it.
+ *
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * @struct ShmLogHeader
+ * @brief Layout of the beginning of the segment, followed by slotCount slots.
+ */
+struct ShmLogHeader {
+    uint32_t magic;                     /**< ShmLogRing::Magic once the segment is initialized. */
+    uint32_t version;                   /**< Layout version. */
+    uint32_t slotCount;                 /**< Number of slots, a power of two. */
+    uint32_t slotSize;                  /**< Size of one slot including its header. */
+    std::atomic<uint64_t> writeSeq;     /**< Number of messages published so far. */
+};
+
+/**
+ * @struct ShmLogSlot
+ * @brief Header of one slot, followed by the message bytes.
+ */
+struct ShmLogSlot {
+    std::atomic<uint64_t> seq;          /**< 2 * n + 1 while message n is written, 2 * n + 2 once done. */
+    uint32_t length;                    /**< Length of the message in bytes. */
+    uint32_t flags;                     /**< ShmLogSlot::Dropped for a message that did not fit. */
+
+    static constexpr uint32_t Dropped = 1;  ///< The message was too large, the slot holds no payload.
+};
+
+/**
+ * @class ShmLogRing
+ * @brief Single-producer side of the ring, owned by the interpreter.
+ */
+class ShmLogRing {
+public:
+    static constexpr uint32_t Magic = 0x46534d4c;       ///< "FSML"
+    static constexpr uint32_t Version = 2;              ///< Current layout version.
+    static constexpr uint32_t DefaultSlotCount = 1024;  ///< Default number of slots.
+    static constexpr uint32_t DefaultSlotSize = 4096;   ///< Default slot size in bytes.
+
+    /**
+     * @brief Creates the shared memory segment, replacing a previous one of the same name.
+     *
+     * A previous segment is unlinked, never truncated, so readers still attached to it keep a
+     * valid mapping. They have to attach again to follow the new segment.
+     *
+     * @param name Name of the segment, e.g. "/fsmcraft-log".
+     * @param slotCount Number of slots, rounded up to a power of two.
+     * @param slotSize Size of one slot, the largest message is slotSize - sizeof(ShmLogSlot).
+     */
+    ShmLogRing(const std::string& name,
+               uint32_t slotCount = DefaultSlotCount,
+               uint32_t slotSize = DefaultSlotSize);
+
+    /**
+     * @brief Unmaps and unlinks the segment unless it was replaced, attached readers keep their mapping.
+     */
+    ~ShmLogRing();
+
+    ShmLogRing(const ShmLogRing&) = delete;
+    ShmLogRing& operator=(const ShmLogRing&) = delete;
+
+    /**
+     * @brief Checks whether the segment was created successfully.
+     * @return True if messages can be published.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Publishes a message, never blocks. Must be called from one thread at a time.
+     * @param msg The message without delimiter.
+     * @return False if the ring is not open or the message does not fit into a slot, in which
+     *         case readers are told that a message was dropped.
+     */
+    bool publish(const std::string& msg);
+
+    /**
+     * @brief Gets the number of messages dropped because they exceeded the slot size.
+     * @return Dropped message count.
+     */
+    uint64_t oversizedCount() const;
+
+    /**
+     * @brief Reads the segment name from the FSMCRAFT_SHM_LOG environment variable.
+     * @return The segment name, empty when publishing to shared memory is disabled.
+     */
+    static std::string nameFromEnvironment();
+
+private:
+    std::string name;                   /**< Name of the segment. */
+    void* mapping = nullptr;            /**< Start of the mapped segment. */
+    size_t mappingSize = 0;             /**< Size of the mapping in bytes. */
+    ShmLogHeader* header = nullptr;     /**< Header at the start of the mapping. */
+    char* slots = nullptr;              /**< First slot. */
+    uint32_t slotMask = 0;              /**< slotCount - 1. */
+    uint32_t slotSize = 0;              /**< Size of one slot in bytes. */
+    uint64_t nextSeq = 0;               /**< Sequence number of the next message. */
+    std::atomic<uint64_t> oversized{0}; /**< Messages dropped for their size. */
+    dev_t device = 0;                   /**< Device of the created segment. */
+    ino_t inode = 0;                    /**< Inode of the created segment, unlinked only while the name refers to it. */
+};
+
+/**
+ * @class ShmLogReader
+ * @brief Consumer side of the ring, any number of readers may be attached.
+ */
+class ShmLogReader {
+public:
+    /**
+     * @enum PollResult
+     * @brief Outcome of a single poll() call.
+     */
+    enum class PollResult {
+        OK,         ///< A message was read.
+        EMPTY,      ///< No new message was published.
+        OVERRUN,    ///< The reader fell behind, lost messages were skipped.
+        DROPPED     ///< The publisher dropped a message too large for a slot.
+    };
+
+    ShmLogReader() = default;
+    ~ShmLogReader();
+
+    ShmLogReader(const ShmLogReader&) = delete;
+    ShmLogReader& operator=(const ShmLogReader&) = delete;
+
+    /**
+     * @brief Attaches read-only to an existing segment.
+     * @param name Name of the segment.
+     * @param fromOldest Start with the oldest message still in the ring instead of the next new one.
+     * @return True if the segment exists and is initialized.
+     */
+    bool attach(const std::string& name, bool fromOldest = false);
+
+    /**
+     * @brief Detaches from the segment.
+     */
+    void detach();
+
+    /**
+     * @brief Reads the next message without blocking.
+     * @param msg Receives the message when OK is returned.
+     * @param lost Receives the number of skipped messages when OVERRUN or DROPPED is returned.
+     * @return Result of the poll.
+     */
+    PollResult poll(std::string& msg, uint64_t& lost);
+
+    /**
+     * @brief Gets the sequence number of the next message to be read.
+     * @return Sequence number.
+     */
+    uint64_t position() const;
+
+private:
+    /**
+     * @brief Gets the slot holding the given message.
+     * @param seq Sequence number of the message.
+     * @return Pointer to the slot.
+     */
+    const ShmLogSlot* slotFor(uint64_t seq) const;
+
+    void* mapping = nullptr;                /**< Start of the mapped segment. */
+    size_t mappingSize = 0;                 /**< Size of the mapping in bytes. */
+    const ShmLogHeader* header = nullptr;   /**< Header at the start of the mapping. */
+    const char* slots = nullptr;            /**< First slot. */
+    uint32_t slotCount = 0;                 /**< Number of slots. */
+    uint32_t slotSize = 0;                  /**< Size of one slot in bytes. */
+    uint64_t nextSeq = 0;                   /**< Sequence number of the next message to read. */
+};
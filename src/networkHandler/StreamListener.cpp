@@ -0,0 +1,183 @@
+/**
+ * @file StreamListener.cpp
+ * @brief Implementation of the StreamListener class for handling stream socket connections and communication.
+ * @author xlesigm00
+ * @date 05.05.2025
+ */
+
+#include "NetworkHandler.h"
+#include <cerrno>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief Handles communication with a connected client.
+ * This function reads messages from the client and passes each of them to the callback
+ * until the client disconnects.
+ * 
+ * @param client_socket Socket ID for the client.
+ * @param onMessage Callback to handle received messages.
+ */
+static void handleClientCommunication(int client_socket, const std::function<void(const std::string&, int)>& onMessage) {
+    MessageFramer framer;         /**< Reusable buffer framing the received data. */
+
+    while (true) {
+        ssize_t bytesRead = framer.fill(client_socket);
+
+        // If no data is received, or connection is closed, break the loop
+        if (bytesRead <= 0) {
+            FSM_LOG_INFO("Client " + std::to_string(client_socket) + " disconnected.");
+            close(client_socket);
+            break;
+        }
+
+        // Process complete messages delimited by "\r\n"
+        std::string_view view;
+        while (framer.next(view)) {
+            std::string msg(view);
+
+            FSM_LOG_DEBUG("Server: received message from socket " + std::to_string(client_socket) + ": " + msg);
+
+            try {
+                onMessage(msg, client_socket);
+            } catch (const std::exception& e) {
+                FSM_LOG_ERROR(std::string("Error processing message: ") + e.what());
+            }
+        }
+    }
+}
+
+/**
+ * @brief Starts the listener to accept incoming client connections and process their messages.
+ * It also handles the disconnection of clients and stops when stopListening() is called.
+ * 
+ * @param port The port number to listen on.
+ * @param onMessage Callback function that handles received messages.
+ * @param onDisconnect Callback function to handle client disconnections.
+ * @param onReady Callback told whether the socket was bound, before the first accept().
+ */
+void StreamListener::startListening(int port,
+    std::function<void(const std::string&, int)> onMessage,
+    std::function<void(int)> onDisconnect,
+    std::function<void(bool)> onReady) {
+
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex);
+        stopReceived.store(false);
+    }
+    int server_fd = openServerSocket(port);
+    if (server_fd < 0) {
+        if (onReady) {
+            onReady(false);
+        }
+        return;
+    }
+    {
+        // stopListening() either sees the port or the loop below sees its flag
+        std::lock_guard<std::mutex> lock(listenerMutex);
+        listeningPort = port;
+    }
+
+    // Clients may connect from now on, the backlog holds them until accept()
+    if (onReady) {
+        onReady(true);
+    }
+
+    std::vector<std::thread> clientThreads; /**< Vector to store client handling threads. */
+
+    while (!stopReceived.load()) {
+        int client_socket = accept(server_fd, nullptr, nullptr);
+        if (client_socket < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            FSM_LOG_ERROR(std::string("accept: ") + strerror(errno));
+            break;
+        }
+
+        if (stopReceived.load()) {
+            // Connection made by stopListening() to unblock accept()
+            close(client_socket);
+            break;
+        }
+
+        FSM_LOG_INFO("Client connected! Socket: " + std::to_string(client_socket));
+
+        // Start client thread to handle communication
+        std::thread t([client_socket, onMessage, onDisconnect]() {
+            handleClientCommunication(client_socket, onMessage);
+            if (onDisconnect) {
+                onDisconnect(client_socket);  // Call the disconnect handler after communication
+            }
+        });
+        clientThreads.push_back(std::move(t));  // Store the thread
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex);
+        listeningPort = -1;
+    }
+    close(server_fd);
+    cleanupServerSocket(port);
+    FSM_LOG_INFO("Server has stopped accepting clients.");
+
+    // Wait for the connected clients to finish
+    for (auto& t : clientThreads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+/**
+ * @brief Sends a single message to a connected client, appending the delimiter.
+ * 
+ * @param clientSocket Socket of the client.
+ * @param msg The message to send.
+ * @return true if the whole message was sent, false otherwise.
+ */
+bool StreamListener::sendToClient(int clientSocket, const std::string& msg) {
+    std::string fullMessage = msg + "\r\n";
+    const char* data = fullMessage.data();
+    size_t remaining = fullMessage.size();
+
+    while (remaining > 0) {
+        ssize_t sent = ::send(clientSocket, data, remaining, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += sent;
+        remaining -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+/**
+ * @brief Stops accepting clients by setting the flag and unblocking accept().
+ */
+void StreamListener::stopListening() {
+    int port = -1;
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex);
+        if (stopReceived.exchange(true)) {
+            return;
+        }
+        port = listeningPort;
+    }
+    if (port >= 0) {
+        connectToSelf(port);
+    }
+}
+
+/**
+ * @brief Nothing to release for sockets without a filesystem entry.
+ * 
+ * @param port Port the listener was bound to.
+ */
+void StreamListener::cleanupServerSocket(int) {}
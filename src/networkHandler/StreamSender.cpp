@@ -0,0 +1,268 @@
+/**
+ * @file StreamSender.cpp
+ * @brief Implementation of the StreamSender class shared by TCP and UNIX domain sockets.
+ * @author xlesigm00
+ * @date 05.05.2025
+ */
+
+#include "NetworkHandler.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <mutex>
+#include <sys/uio.h>
+
+/**
+ * @brief Delimiter sent after every message.
+ */
+static const char messageDelimiter[] = "\r\n";
+
+/**
+ * @brief Sends all buffers with as few sendmsg() calls as possible.
+ * 
+ * Partial sends advance through the buffers, a signal interrupting the call is retried.
+ * 
+ * @param fd Socket to send to.
+ * @param buffers Buffers to send in order, modified while sending.
+ * @return true if everything was sent, false on a socket error.
+ */
+static bool sendAll(int fd, std::vector<iovec>& buffers) {
+    size_t index = 0;
+    while (index < buffers.size()) {
+        msghdr header{};
+        header.msg_iov = buffers.data() + index;
+        header.msg_iovlen = std::min<size_t>(buffers.size() - index, IOV_MAX);
+
+        ssize_t sent = ::sendmsg(fd, &header, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        // Skip the buffers sent completely and the sent part of the next one
+        size_t remaining = static_cast<size_t>(sent);
+        while (index < buffers.size() && remaining >= buffers[index].iov_len) {
+            remaining -= buffers[index].iov_len;
+            ++index;
+        }
+        if (remaining > 0) {
+            buffers[index].iov_base = static_cast<char*>(buffers[index].iov_base) + remaining;
+            buffers[index].iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sends the messages still queued and closes the connection.
+ */
+StreamSender::~StreamSender() {
+    closeConnection();
+}
+
+/**
+ * @brief Sets the host and port for the connection.
+ * 
+ * The new address is used by the next connectToServer() call.
+ * 
+ * @param host The host address to connect to.
+ * @param port The port number to connect to.
+ */
+void StreamSender::setHostAndPort(const std::string& host, int port) {
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    this->host = host;
+    this->port = port;
+}
+
+/**
+ * @brief Connects to the server using the set host and port.
+ * 
+ * This method lets the concrete transport create a socket and connect it to
+ * the server, errors are reported by the transport. A connection whose writer
+ * failed is released first, then a writer is started for the new connection.
+ * 
+ * @return true if the connection is successful, false otherwise.
+ */
+bool StreamSender::connectToServer() {
+    std::lock_guard<std::mutex> lock(connectionMutex);
+
+    if (sock != -1) {
+        if (writable) {
+            FSM_LOG_WARNING("Already connected. Close the current connection before reusing.");
+            return false;
+        }
+        releaseConnection();
+    }
+
+    framer.reset();
+    int fd = openSocket();
+    if (fd == -1) {
+        return false;
+    }
+
+    uint64_t id = connection.load() + 1;
+    connection.store(id);
+    sock = fd;
+    {
+        std::lock_guard<std::mutex> writerLock(writerMutex);
+        writerExited = false;
+    }
+    writable.store(true, std::memory_order_release);
+    writer = std::thread(&StreamSender::writeLoop, this, fd, id);
+    return true;
+}
+
+/**
+ * @brief Receives a message from the server.
+ * 
+ * This method reads from the server socket until the framer yields a complete
+ * "\r\n" delimited message and returns it. Readers of the same connection are
+ * serialized, senders are never blocked by a reader.
+ * 
+ * @return The received message from the server, or an empty string in case of errors.
+ */
+std::string StreamSender::recvMessage() {
+    std::lock_guard<std::mutex> lock(readMutex);
+
+    std::string_view message; /**< View of the next framed message. */
+
+    // Keep reading until a complete message is buffered
+    while (!framer.next(message)) {
+        int fd = sock.load();
+        if (fd < 0) {
+            FSM_LOG_ERROR("Invalid socket, cannot receive data!");
+            return "";  // Or handle the error appropriately
+        }
+
+        ssize_t bytesRead = framer.fill(fd);
+        if (bytesRead <= 0) {
+            if (bytesRead < 0) {
+                FSM_LOG_ERROR(std::string("Receive failed: ") + strerror(errno));
+            } else {
+                FSM_LOG_INFO("Connection closed by server.");
+            }
+            return "";
+        }
+    }
+
+    return std::string(message);
+}
+
+/**
+ * @brief Closes the connection to the server.
+ * 
+ * Messages queued before the call are still sent, then the writer stops and
+ * the socket is closed.
+ */
+void StreamSender::closeConnection() {
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    releaseConnection();
+}
+
+void StreamSender::releaseConnection() {
+    int fd = sock.load();
+    if (fd == -1) {
+        return;
+    }
+
+    // The marker follows every message queued so far, the writer sends them and stops at it
+    writable.store(false);
+    Outbound marker;
+    marker.connection = connection.load();
+    marker.last = true;
+    outbound.push(std::move(marker));
+    {
+        std::unique_lock<std::mutex> writerLock(writerMutex);
+        if (!writerDone.wait_for(writerLock, std::chrono::milliseconds(CloseTimeoutMs), [this]() { return writerExited; })) {
+            // The peer stopped reading, fail the blocked send instead of waiting for it
+            FSM_LOG_WARNING("Peer is not reading, dropping unsent messages of sock: " + std::to_string(fd));
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    FSM_LOG_INFO("Connection closed for sock: " + std::to_string(fd));
+    close(fd);
+    sock = -1;
+}
+
+/**
+ * @brief Queues a message for the connected server.
+ * 
+ * The call never blocks and never makes a system call, the writer of the
+ * connection sends the message together with everything else queued by then.
+ * Send errors are reported by the writer, which stops accepting messages.
+ * 
+ * @param msg The message to be sent to the server.
+ * @return true if the message was queued, false if not connected.
+ */
+bool StreamSender::sendMessage(const std::string& msg) {
+    if (!writable.load(std::memory_order_acquire)) {
+        FSM_LOG_ERROR("Not connected! Call connectToServer first.");
+        return false;
+    }
+
+    Outbound message;
+    message.payload = msg;
+    message.connection = connection.load(std::memory_order_acquire);
+    return outbound.push(std::move(message));
+}
+
+void StreamSender::writeLoop(int fd, uint64_t id) {
+    // Tells releaseConnection() the writer is gone, however the loop ends
+    struct ExitNotice {
+        StreamSender* sender;
+        ~ExitNotice() {
+            {
+                std::lock_guard<std::mutex> lock(sender->writerMutex);
+                sender->writerExited = true;
+            }
+            sender->writerDone.notify_all();
+        }
+    } exitNotice{this};
+
+    std::vector<Outbound> batch;
+    std::vector<iovec> buffers;
+    batch.reserve(MaxBatch);
+    buffers.reserve(2 * MaxBatch);
+
+    Outbound message;
+    bool open = true;
+    while (open && outbound.waitPop(message)) {
+        // Gather whatever is queued, messages left over from an earlier connection are dropped
+        batch.clear();
+        do {
+            if (message.connection != id) {
+                continue;
+            }
+            if (message.last) {
+                open = false;
+                break;
+            }
+            batch.push_back(std::move(message));
+        } while (batch.size() < MaxBatch && outbound.tryPop(message));
+
+        if (batch.empty()) {
+            continue;
+        }
+
+        buffers.clear();
+        for (Outbound& queued : batch) {
+            buffers.push_back({queued.payload.data(), queued.payload.size()});
+            buffers.push_back({const_cast<char*>(messageDelimiter), 2});
+        }
+
+        if (!sendAll(fd, buffers)) {
+            FSM_LOG_ERROR(std::string("Send failed: ") + strerror(errno) + " (" + std::to_string(errno) + ")");
+            writable.store(false);
+            shutdown(fd, SHUT_RDWR);  // Wake up a blocked reader, the socket is closed by the owner
+            return;
+        }
+        FSM_LOG_DEBUG("Sent " + std::to_string(batch.size()) + " messages from socket " + std::to_string(fd));
+    }
+}
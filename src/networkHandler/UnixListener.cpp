@@ -0,0 +1,85 @@
+/**
+ * @file UnixListener.cpp
+ * @brief Implementation of the UnixListener class for handling UNIX domain socket connections.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#include "NetworkHandler.h"
+#include <cerrno>
+#include <sys/un.h>
+
+std::string unixSocketPath(int port) {
+    return "/tmp/fsmcraft-" + std::to_string(port) + ".sock";
+}
+
+/**
+ * @brief Fills the UNIX domain socket address for the given port.
+ * 
+ * @param port The port identifying the socket path.
+ * @return The socket address.
+ */
+static sockaddr_un unixAddress(int port) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::string path = unixSocketPath(port);
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+/**
+ * @brief Creates the UNIX domain server socket, replacing a stale socket file.
+ * 
+ * @param port The port identifying the socket path.
+ * @return Listening socket descriptor, -1 on failure.
+ */
+int UnixListener::openServerSocket(int port) {
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_fd < 0) {
+        FSM_LOG_ERROR(std::string("socket: ") + strerror(errno));
+        return -1;
+    }
+
+    sockaddr_un address = unixAddress(port);
+    unlink(address.sun_path);
+
+    if (bind(server_fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        FSM_LOG_ERROR(std::string("bind: ") + strerror(errno));
+        close(server_fd);
+        return -1;
+    }
+
+    if (listen(server_fd, SOMAXCONN) < 0) {
+        FSM_LOG_ERROR(std::string("listen: ") + strerror(errno));
+        close(server_fd);
+        unlink(address.sun_path);
+        return -1;
+    }
+
+    FSM_LOG_INFO("Listening for clients on " + unixSocketPath(port) + "...");
+    return server_fd;
+}
+
+/**
+ * @brief Connects to the own socket path to unblock accept().
+ * 
+ * @param port The port identifying the socket path.
+ */
+void UnixListener::connectToSelf(int port) {
+    sockaddr_un address = unixAddress(port);
+
+    int unblockSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (unblockSocket >= 0) {
+        connect(unblockSocket, (sockaddr*)&address, sizeof(address));
+        close(unblockSocket);
+    }
+}
+
+/**
+ * @brief Removes the socket file once the listener stops.
+ * 
+ * @param port The port identifying the socket path.
+ */
+void UnixListener::cleanupServerSocket(int port) {
+    unlink(unixSocketPath(port).c_str());
+}
@@ -0,0 +1,36 @@
+/**
+ * @file UnixSender.cpp
+ * @brief Implementation of the UnixSender class.
+ * @author xlesigm00
+ * @date 18.10.2026
+ */
+
+#include "NetworkHandler.h"
+#include <sys/un.h>
+
+/**
+ * @brief Creates a UNIX domain socket and connects it to the path derived from the port.
+ * 
+ * @return Connected socket descriptor, -1 on failure.
+ */
+int UnixSender::openSocket() {
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock == -1) {
+        FSM_LOG_ERROR("Socket creation failed!");
+        return -1;
+    }
+
+    std::string path = unixSocketPath(port);
+    sockaddr_un server{};            /**< Server socket address. */
+    server.sun_family = AF_UNIX;
+    std::strncpy(server.sun_path, path.c_str(), sizeof(server.sun_path) - 1);
+
+    if (connect(sock, (struct sockaddr*)&server, sizeof(server)) < 0) {
+        FSM_LOG_WARNING("Connection failed!");
+        close(sock);
+        return -1;
+    }
+
+    FSM_LOG_INFO("Connected to server: " + path);
+    return sock;
+}
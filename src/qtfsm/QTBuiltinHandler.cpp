@@ -8,30 +8,68 @@
 
 #include "QTBuiltinHandler.h"
 #include <QDebug>
+#include <QJSEngine>
+#include <QJSValueIterator>
 #include "QTfsm.h"
+#include "../common/SessionClock.h"
 
 QTBuiltinHandler::QTBuiltinHandler(QObject* parent, QTfsm* fsm)
     : QObject(parent), fsm(fsm) {
 }
 
+QJSValue QTBuiltinHandler::install(QJSEngine& engine) {
+    pendingOutputs = engine.newObject();
+    definedInputs = engine.newObject();
+    stateClock = engine.newObject();
+    stateClock.setProperty("entered", -1);
 
-void QTBuiltinHandler::output(const QString& name, const QString& value) {
-    qDebug() << "JS output:" << name << "=" << value;
-    
-   fsm->setOutput(name, value);
+    // Bound once, every call stays inside the engine
+    QJSValue factory = engine.evaluate(
+        "(function (outputs, inputs, clock, native) {"
+        "    return {"
+        "        output: function (name, value) { outputs[name] = value; },"
+        "        outputs: function (values) {"
+        "            for (var name in values) outputs[name] = values[name];"
+        "        },"
+        "        elapsed: function () { return clock.entered < 0 ? 0 : native.monotonicMs() - clock.entered; },"
+        "        defined: function (name) { return inputs[name] === true; }"
+        "    };"
+        "})");
+    QJSValue builtins = factory.call({pendingOutputs, definedInputs, stateClock, engine.newQObject(this)});
+    if (builtins.isError()) {
+        qWarning() << "Cannot create builtin functions:" << builtins.toString();
+    }
+    return builtins;
+}
+
+void QTBuiltinHandler::collectOutputs(const std::function<void(const QString&, const QJSValue&)>& apply) {
+    if (pendingOutputs.isUndefined()) {
+        return;
+    }
+
+    QJSValueIterator it(pendingOutputs);
+    QStringList names;
+    while (it.hasNext()) {
+        it.next();
+        names.append(it.name());
+        apply(it.name(), it.value());
+    }
+    for (const QString& name : names) {
+        pendingOutputs.deleteProperty(name);
+    }
 }
 
-int QTBuiltinHandler::elapsed() {
-    return stateTimer.isValid() ? stateTimer.elapsed() : 0;
+void QTBuiltinHandler::inputDefined(const QString& name) {
+    definedInputs.setProperty(name, true);
 }
 
-bool QTBuiltinHandler::defined(const QString& name) {
-    return fsm->map.contains(name);
+double QTBuiltinHandler::monotonicMs() const {
+    return static_cast<double>(SessionClock::monotonicNs() / 1000000);
 }
 
 void QTBuiltinHandler::stateEntered(QState* newState) {
     if (newState != lastActiveState) {
-        stateTimer.restart();
+        stateClock.setProperty("entered", monotonicMs());
         lastActiveState = newState;
     }
-}
\ No newline at end of file
+}
@@ -1,11 +1,11 @@
 /**
  * @file QTBuiltinHandler.h
  * @brief Header file of built-in functions for the JS engine integration in QTfsm.
- * 
- * This class provides slots that can be used as built-in handlers within a QT-based
- * FSM system. It offers functionality such as checking if an output is defined,
- * measuring elapsed time, and tracking state transitions.
- * 
+ *
+ * This class installs the functions of the "fsm" object that can be used as built-in handlers
+ * within a QT-based FSM system. It offers functionality such as setting outputs, checking if
+ * an input is defined, measuring elapsed time, and tracking state transitions.
+ *
  * @author xnovakf00
  * @date 08.05.2025
  */
@@ -14,18 +14,25 @@
 
 #include <QObject>
 #include <QString>
-#include "QTfsm.h"
-#include <QElapsedTimer>
+#include <QJSValue>
+#include <QState>
+#include <functional>
 
+class QJSEngine;
 class QTfsm; ///< Forward declaration of QTfsm
 
 /**
  * @class QTBuiltinHandler
- * @brief Provides built-in slots for use in the JS-based FSM scripting environment.
+ * @brief Provides the built-in functions of the JS-based FSM scripting environment.
  *
- * The QTBuiltinHandler class exposes several common functions—such as output control,
- * time measurement, and state transition handling—that can be invoked from a JS context
- * inside the FSM system.
+ * The functions are plain JS closures bound once when the engine is initialized. They only
+ * touch JS objects the handler keeps handles to, so a call from a script goes through the
+ * meta-object system only to read the monotonic clock, which JS itself does not offer:
+ * - fsm.output(name, value) and fsm.outputs({name: value, ...}) record outputs, read back by
+ *   collectOutputs() before they are published,
+ * - fsm.elapsed() subtracts the monotonic state entry time stored on every state change,
+ *   so changes of the wall clock do not move timeouts,
+ * - fsm.defined(name) looks the input up in an object filled when an input is first received.
  */
 class QTBuiltinHandler : public QObject {
     Q_OBJECT
@@ -38,26 +45,24 @@ public:
      */
     explicit QTBuiltinHandler(QObject* parent = nullptr, QTfsm* fsm = nullptr);
 
-public slots:
     /**
-     * @brief Sets the output
-     * @param name Name of the output.
-     * @param value Value to emit.
+     * @brief Creates the "fsm" object with the builtin functions.
+     * @param engine Engine the scripts run in.
+     * @return The object to set as the "fsm" global.
      */
-    void output(const QString& name, const QString& value);
+    QJSValue install(QJSEngine& engine);
 
     /**
-     * @brief Returns the number of milliseconds elapsed since the last state transition.
-     * @return Time elapsed in milliseconds.
+     * @brief Passes the outputs set by scripts since the last call to the callback.
+     * @param apply Receives the name and the value of every changed output.
      */
-    int elapsed();
+    void collectOutputs(const std::function<void(const QString&, const QJSValue&)>& apply);
 
     /**
-     * @brief Checks whether the given output is defined in the JSengine.
-     * @param name Name of the output.
-     * @return True if defined, false otherwise.
+     * @brief Records that the input received its first value, for fsm.defined().
+     * @param name Name of the input.
      */
-    bool defined(const QString& name);
+    void inputDefined(const QString& name);
 
     /**
      * @brief Updates the internal state tracking when a new state is entered.
@@ -65,14 +70,26 @@ public slots:
      */
     void stateEntered(QState* newState);
 
+    /**
+     * @brief Reads the monotonic clock for fsm.elapsed().
+     * @return Milliseconds since an unspecified point, never decreasing.
+     */
+    Q_INVOKABLE double monotonicMs() const;
+
 private:
     /** @brief Pointer to the FSM instance used by this handler. */
     QTfsm* fsm;
 
-    /** @brief Timer used to track elapsed time since the last state transition. */
-    QElapsedTimer stateTimer;
+    /** @brief Outputs written by scripts since the last collection, by name. */
+    QJSValue pendingOutputs;
+
+    /** @brief Names of the inputs that received a value, mapped to true. */
+    QJSValue definedInputs;
 
-    /** 
+    /** @brief Holds "entered", the monotonic time of the last state change in ms. */
+    QJSValue stateClock;
+
+    /**
      * @brief Last active state entered in the FSM, if states are same after transition
      * the time should not be reset
      */
@@ -9,12 +9,20 @@
 #pragma once
 #include <QEvent>
 #include <QVariant>
+#include <cstdint>
+#include "QTInputStore.h"
 
 constexpr QEvent::Type JsConditionEventType = static_cast<QEvent::Type>(QEvent::User + 1);
 
+/**
+ * @brief Event testing the transitions, carries only the changed input and the input version
+ * the conditions are evaluated at. The version stays pinned in the store until the event is deleted.
+ */
 struct JsConditionEvent : public QEvent {
-    JsConditionEvent(const QVariantMap& data, QString& inputKey)
-        : QEvent(JsConditionEventType), eventData(data), inputKey(inputKey) {}
-    QVariantMap eventData;
-    QString inputKey;
-};
\ No newline at end of file
+    JsConditionEvent(const QString& inputKey, QTInputStore::Pin pin, const QVariant& value = QVariant())
+        : QEvent(JsConditionEventType), inputKey(inputKey), value(value), version(pin.version()), pin(std::move(pin)) {}
+    QString inputKey;   ///< Changed input, empty for epsilon and timer events
+    QVariant value;     ///< New value of the input
+    uint64_t version;   ///< Version of the input store when the event was posted
+    QTInputStore::Pin pin;  ///< Keeps the changes the event syncs to
+};
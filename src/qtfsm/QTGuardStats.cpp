@@ -0,0 +1,108 @@
+/**
+ * @file QTGuardStats.cpp
+ * @brief Implementation of the runtime statistics deciding the order in which guards are tried.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "QTGuardStats.h"
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+/** @brief Version of the statistics file layout. */
+static constexpr int GuardStatsVersion = 1;
+
+void QTGuardStats::registerGuard(int id, const QString& condition) {
+    Guard& guard = guards[id];
+    if (guard.condition != condition) {
+        guard = Guard();
+        guard.condition = condition;
+    }
+}
+
+bool QTGuardStats::record(int id, bool pass, uint64_t costNs) {
+    Guard& guard = guards[id];
+    ++guard.evaluations;
+    guard.passes += pass ? 1 : 0;
+    guard.costNs += costNs;
+
+    if (++sinceReorder < ReorderInterval) {
+        return false;
+    }
+    sinceReorder = 0;
+    return true;
+}
+
+double QTGuardStats::score(int id) const {
+    auto it = guards.constFind(id);
+    if (it == guards.constEnd()) {
+        return 0.5;
+    }
+
+    // Laplace estimate of the pass rate, so unseen guards are neither first nor last
+    const Guard& guard = it.value();
+    double probability = (guard.passes + 1.0) / (guard.evaluations + 2.0);
+    double cost = guard.evaluations == 0 ? 1.0 : 1.0 + static_cast<double>(guard.costNs) / guard.evaluations;
+    return probability / cost;
+}
+
+bool QTGuardStats::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != GuardStatsVersion) {
+        return false;
+    }
+
+    QJsonObject saved = root.value("guards").toObject();
+    for (auto it = saved.constBegin(); it != saved.constEnd(); ++it) {
+        bool ok = false;
+        int id = it.key().toInt(&ok);
+        QJsonObject entry = it.value().toObject();
+        auto guard = guards.find(id);
+
+        // Only guards of the loaded automaton whose condition did not change
+        if (!ok || guard == guards.end() || guard->condition != entry.value("condition").toString()) {
+            continue;
+        }
+        guard->evaluations = static_cast<uint64_t>(entry.value("evaluations").toDouble());
+        guard->passes = static_cast<uint64_t>(entry.value("passes").toDouble());
+        guard->costNs = static_cast<uint64_t>(entry.value("costNs").toDouble());
+    }
+    return true;
+}
+
+bool QTGuardStats::save(const QString& path) const {
+    QJsonObject saved;
+    for (auto it = guards.constBegin(); it != guards.constEnd(); ++it) {
+        QJsonObject entry;
+        entry["condition"] = it->condition;
+        entry["evaluations"] = static_cast<double>(it->evaluations);
+        entry["passes"] = static_cast<double>(it->passes);
+        entry["costNs"] = static_cast<double>(it->costNs);
+        saved[QString::number(it.key())] = entry;
+    }
+
+    QJsonObject root;
+    root["version"] = GuardStatsVersion;
+    root["guards"] = saved;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    return file.commit();
+}
+
+QString QTGuardStats::pathFor(const QString& jsonPath) {
+    QFileInfo info(jsonPath);
+    return info.dir().filePath(info.completeBaseName() + ".guardstats.json");
+}
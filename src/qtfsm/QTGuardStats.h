@@ -0,0 +1,84 @@
+/**
+ * @file QTGuardStats.h
+ * @brief Header of the runtime statistics deciding the order in which guards are tried.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <cstdint>
+
+/**
+ * @class QTGuardStats
+ * @brief Pass rate and evaluation cost of every guard, persisted beside the automaton JSON.
+ *
+ * For mutually exclusive guards, trying them by decreasing pass probability per unit of cost
+ * minimizes the expected cost of finding the enabled one, so score() ranks guards by that ratio.
+ */
+class QTGuardStats {
+public:
+    /** @brief Evaluations between two reorderings. */
+    static constexpr uint64_t ReorderInterval = 256;
+
+    /**
+     * @brief Registers a guard, statistics loaded for a different condition are dropped.
+     * @param id Id of the transition.
+     * @param condition JS condition of the guard.
+     */
+    void registerGuard(int id, const QString& condition);
+
+    /**
+     * @brief Records one evaluation of a guard.
+     * @param id Id of the transition.
+     * @param pass Result of the guard.
+     * @param costNs Evaluation time in nanoseconds.
+     * @return True every ReorderInterval evaluations, when the order should be revised.
+     */
+    bool record(int id, bool pass, uint64_t costNs);
+
+    /**
+     * @brief Ranks a guard, higher scores are tried first.
+     * @param id Id of the transition.
+     * @return Estimated pass probability divided by the average cost.
+     */
+    double score(int id) const;
+
+    /**
+     * @brief Loads statistics saved by an earlier run.
+     * @param path Path of the statistics file.
+     * @return False if the file is missing or malformed.
+     */
+    bool load(const QString& path);
+
+    /**
+     * @brief Saves the statistics.
+     * @param path Path of the statistics file.
+     * @return False if the file could not be written.
+     */
+    bool save(const QString& path) const;
+
+    /**
+     * @brief Derives the statistics file from the path of the automaton JSON.
+     * @param jsonPath Path of the automaton, e.g. "examples/tof.json".
+     * @return Path beside it, e.g. "examples/tof.guardstats.json".
+     */
+    static QString pathFor(const QString& jsonPath);
+
+private:
+    /**
+     * @struct Guard
+     * @brief Statistics of one guard.
+     */
+    struct Guard {
+        QString condition;          /**< Condition the statistics belong to. */
+        uint64_t evaluations = 0;   /**< Number of evaluations. */
+        uint64_t passes = 0;        /**< Number of evaluations that passed. */
+        uint64_t costNs = 0;        /**< Total evaluation time. */
+    };
+
+    QHash<int, Guard> guards;       /**< Statistics by transition id. */
+    uint64_t sinceReorder = 0;      /**< Evaluations since the last reordering. */
+};
@@ -0,0 +1,99 @@
+/**
+ * @file QTInputStore.cpp
+ * @brief Implementation of the versioned store of the input values of the FSM.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "QTInputStore.h"
+#include <QSet>
+#include <algorithm>
+
+uint64_t QTInputStore::set(const QString& key, const QVariant& value) {
+    values[key] = value;
+    pending.push_back({++current, key, value});
+
+    // Nothing synced for a long time, intermediate values of the same input are not needed
+    if (pending.size() > std::max(collapseAt, 2 * static_cast<size_t>(values.size()) + PendingSlack)) {
+        collapsePending();
+        // Pinned changes cannot be collapsed, do not scan them again on every change
+        collapseAt = 2 * pending.size();
+    }
+    return current;
+}
+
+bool QTInputStore::contains(const QString& key) const {
+    return values.contains(key);
+}
+
+QVariant QTInputStore::value(const QString& key) const {
+    return values.value(key);
+}
+
+uint64_t QTInputStore::version() const {
+    return current;
+}
+
+QTInputStore::Pin QTInputStore::pin() {
+    return Pin(pinned, current);
+}
+
+void QTInputStore::syncTo(uint64_t target, const std::function<void(const QString&, const QVariant&)>& apply) {
+    while (!pending.empty() && pending.front().version <= target) {
+        apply(pending.front().key, pending.front().value);
+        pending.pop_front();
+    }
+}
+
+void QTInputStore::collapsePending() {
+    // An event pinned at v needs the values at v, intermediate values before it are not seen
+    uint64_t floor = pinned->empty() ? current : *pinned->begin();
+
+    QSet<QString> seen;
+    std::deque<Change> latest;
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+        if (it->version > floor) {
+            latest.push_front(std::move(*it));
+        } else if (!seen.contains(it->key)) {
+            seen.insert(it->key);
+            latest.push_front(std::move(*it));
+        }
+    }
+    pending.swap(latest);
+}
+
+QTInputStore::Pin::Pin(const std::shared_ptr<std::multiset<uint64_t>>& pinned, uint64_t version)
+    : pinned(pinned), pinnedVersion(version) {
+    pinned->insert(version);
+}
+
+QTInputStore::Pin::~Pin() {
+    release();
+}
+
+QTInputStore::Pin::Pin(Pin&& other) noexcept
+    : pinned(std::move(other.pinned)), pinnedVersion(other.pinnedVersion) {
+    other.pinned.reset();
+}
+
+QTInputStore::Pin& QTInputStore::Pin::operator=(Pin&& other) noexcept {
+    if (this != &other) {
+        release();
+        pinned = std::move(other.pinned);
+        pinnedVersion = other.pinnedVersion;
+        other.pinned.reset();
+    }
+    return *this;
+}
+
+uint64_t QTInputStore::Pin::version() const {
+    return pinnedVersion;
+}
+
+void QTInputStore::Pin::release() {
+    // Events may outlive the FSM when the machine deletes its queue
+    if (auto versions = pinned.lock()) {
+        versions->erase(versions->find(pinnedVersion));
+    }
+    pinned.reset();
+}
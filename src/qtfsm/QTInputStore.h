@@ -0,0 +1,132 @@
+/**
+ * @file QTInputStore.h
+ * @brief Header of the versioned store of the input values of the FSM.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <set>
+
+/**
+ * @class QTInputStore
+ * @brief Current input values with a version counter and the changes not yet seen by the JS engine.
+ *
+ * Every change gets the next version. Events carry the version they were posted at, and the
+ * engine is brought to exactly that version by applying only the changes made since its last
+ * sync, so a condition sees the inputs as they were when its event was posted.
+ *
+ * Every queued event pins its version. Changes only the pinned versions could still see are
+ * kept, older intermediate values of an input are dropped once too many changes are pending.
+ */
+class QTInputStore {
+public:
+    /** @brief Pending changes kept beyond two per input before they are collapsed. */
+    static constexpr size_t PendingSlack = 64;
+
+    /**
+     * @class Pin
+     * @brief Keeps the changes up to a version from being collapsed while it exists.
+     */
+    class Pin {
+    public:
+        Pin() = default;
+        /**
+         * @brief Pins the version.
+         * @param pinned Pinned versions of the store.
+         * @param version Version to pin.
+         */
+        Pin(const std::shared_ptr<std::multiset<uint64_t>>& pinned, uint64_t version);
+        ~Pin();
+        Pin(Pin&& other) noexcept;
+        Pin& operator=(Pin&& other) noexcept;
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+        /**
+         * @brief Gets the pinned version.
+         * @return The version.
+         */
+        uint64_t version() const;
+
+    private:
+        /**
+         * @brief Unpins the version, the store may be gone already.
+         */
+        void release();
+
+        std::weak_ptr<std::multiset<uint64_t>> pinned;  /**< Pinned versions of the store. */
+        uint64_t pinnedVersion = 0;                     /**< The pinned version. */
+    };
+
+    /**
+     * @brief Sets the value of an input.
+     * @param key Name of the input.
+     * @param value New value.
+     * @return Version of the change.
+     */
+    uint64_t set(const QString& key, const QVariant& value);
+
+    /**
+     * @brief Checks whether the input was ever set.
+     * @param key Name of the input.
+     * @return True if set.
+     */
+    bool contains(const QString& key) const;
+
+    /**
+     * @brief Gets the current value of an input.
+     * @param key Name of the input.
+     * @return The value, invalid if never set.
+     */
+    QVariant value(const QString& key) const;
+
+    /**
+     * @brief Gets the version of the last change.
+     * @return Current version, 0 before the first change.
+     */
+    uint64_t version() const;
+
+    /**
+     * @brief Pins the current version for an event that syncs to it later.
+     * @return Pin to keep with the event.
+     */
+    Pin pin();
+
+    /**
+     * @brief Passes the changes up to the version that were not synced yet to the callback.
+     * @param target Version to bring the consumer to.
+     * @param apply Receives every change in order.
+     */
+    void syncTo(uint64_t target, const std::function<void(const QString&, const QVariant&)>& apply);
+
+private:
+    /**
+     * @struct Change
+     * @brief One change not yet synced.
+     */
+    struct Change {
+        uint64_t version;   /**< Version of the change. */
+        QString key;        /**< Name of the input. */
+        QVariant value;     /**< Value set. */
+    };
+
+    /**
+     * @brief Keeps only the last pending change of every input up to the oldest pinned version.
+     */
+    void collapsePending();
+
+    QHash<QString, QVariant> values;    /**< Current value of every input. */
+    std::deque<Change> pending;         /**< Changes not yet synced, in version order. */
+    uint64_t current = 0;               /**< Version of the last change. */
+    size_t collapseAt = 0;              /**< Pending size after which the next collapse is worth it. */
+    std::shared_ptr<std::multiset<uint64_t>> pinned = std::make_shared<std::multiset<uint64_t>>(); /**< Versions of the queued events. */
+};
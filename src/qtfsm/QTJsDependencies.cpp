@@ -0,0 +1,331 @@
+/**
+ * @file QTJsDependencies.cpp
+ * @brief Implementation of the static analysis of the variables read and written by JS snippets.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#include "QTJsDependencies.h"
+#include <QHash>
+#include <QRegularExpression>
+#include <QSet>
+
+/**
+ * @brief Words that are never global variables.
+ */
+static const QSet<QString> jsKeywords = {
+    "break", "case", "catch", "const", "continue", "default", "delete", "do", "else",
+    "false", "finally", "for", "if", "in", "instanceof", "let", "new", "null", "of",
+    "return", "switch", "throw", "true", "try", "typeof", "undefined", "var", "void", "while",
+    "NaN", "Infinity"
+};
+
+/**
+ * @brief Names giving access to state the analysis cannot follow.
+ */
+static const QSet<QString> opaqueNames = {
+    "eval", "this", "with", "globalThis", "Function", "function", "Date", "arguments", "import"
+};
+
+/**
+ * @brief Global objects whose methods are pure, the rest of their calls are tracked by name.
+ */
+static const QSet<QString> pureGlobals = {
+    "Math", "Number", "String", "Boolean", "parseInt", "parseFloat", "isNaN", "isFinite", "JSON"
+};
+
+/**
+ * @brief Members of the pure globals known to be pure, any other member (Math.random) is opaque.
+ */
+static const QHash<QString, QSet<QString>> pureMembers = {
+    {"Math", {"abs", "acos", "acosh", "asin", "asinh", "atan", "atan2", "atanh", "cbrt", "ceil",
+              "cos", "cosh", "exp", "expm1", "floor", "fround", "hypot", "log", "log10", "log1p",
+              "log2", "max", "min", "pow", "round", "sign", "sin", "sinh", "sqrt", "tan", "tanh",
+              "trunc", "E", "LN10", "LN2", "LOG10E", "LOG2E", "PI", "SQRT1_2", "SQRT2"}},
+    {"Number", {"isFinite", "isInteger", "isNaN", "isSafeInteger", "parseFloat", "parseInt",
+                "EPSILON", "MAX_SAFE_INTEGER", "MAX_VALUE", "MIN_SAFE_INTEGER", "MIN_VALUE",
+                "NaN", "NEGATIVE_INFINITY", "POSITIVE_INFINITY"}},
+    {"String", {"fromCharCode", "fromCodePoint"}},
+    {"JSON", {"parse", "stringify"}}
+};
+
+/**
+ * @brief Builtin handler object exposed to the scripts.
+ */
+static const QString builtinObject = "fsm";
+
+bool JsDependencies::isPure() const {
+    return !opaque && writes.isEmpty() && builtins.isEmpty();
+}
+
+/**
+ * @brief Checks whether the character may start an identifier.
+ * @param c The character.
+ * @return True for letters, '_' and '$'.
+ */
+static bool isIdentifierStart(QChar c) {
+    return c.isLetter() || c == '_' || c == '$';
+}
+
+/**
+ * @brief Checks whether the character may continue an identifier.
+ * @param c The character.
+ * @return True for letters, digits, '_' and '$'.
+ */
+static bool isIdentifierPart(QChar c) {
+    return c.isLetterOrNumber() || c == '_' || c == '$';
+}
+
+/**
+ * @brief Skips whitespace and comments.
+ * @param code The code.
+ * @param pos Position, moved to the next significant character.
+ */
+static void skipSpace(const QString& code, int& pos) {
+    while (pos < code.size()) {
+        if (code[pos].isSpace()) {
+            ++pos;
+        } else if (code.midRef(pos, 2) == QLatin1String("//")) {
+            while (pos < code.size() && code[pos] != '\n') ++pos;
+        } else if (code.midRef(pos, 2) == QLatin1String("/*")) {
+            int end = code.indexOf("*/", pos + 2);
+            pos = end < 0 ? code.size() : end + 2;
+        } else {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Reads the operator starting at the position, longest match first.
+ * @param code The code.
+ * @param pos Position of the operator.
+ * @return The operator, a single character if no longer operator matches.
+ */
+static QString operatorAt(const QString& code, int pos) {
+    static const char* const operators[] = {
+        ">>>=", "===", "!==", "**=", "<<=", ">>=", ">>>", "&&=", "||=", "??=",
+        "=>", "==", "!=", "<=", ">=", "&&", "||", "??", "++", "--",
+        "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "**", "<<", ">>"
+    };
+    for (const char* op : operators) {
+        if (code.midRef(pos).startsWith(QLatin1String(op))) {
+            return QLatin1String(op);
+        }
+    }
+    return pos < code.size() ? QString(code[pos]) : QString();
+}
+
+/**
+ * @brief Checks whether the operator changes its left operand.
+ * @param op The operator.
+ * @return True for =, compound assignments, ++ and --.
+ */
+static bool isWrite(const QString& op) {
+    static const QSet<QString> writing = {
+        "=", "+=", "-=", "*=", "/=", "%=", "**=", "<<=", ">>=", ">>>=", "&=", "|=", "^=",
+        "&&=", "||=", "??=", "++", "--"
+    };
+    return writing.contains(op);
+}
+
+JsDependencies analyzeJsDependencies(const QString& code) {
+    JsDependencies result;
+    result.opaque = false;
+
+    QSet<QString> reads;
+    QSet<QString> writes;
+    QSet<QString> builtins;
+    QString previousIdentifier;     // Identifier right before a '.', empty otherwise
+    QString previousOperator;       // Last token if it was an operator or punctuation
+    bool afterDot = false;          // Whether the last significant token was '.'
+    bool afterDeclaration = false;  // Whether the last significant token was var, let or const
+
+    int pos = 0;
+    while (true) {
+        skipSpace(code, pos);
+        if (pos >= code.size()) {
+            break;
+        }
+        QChar c = code[pos];
+
+        if (c == '"' || c == '\'' || c == '`') {
+            // String literal, a template with substitutions may read anything
+            int end = pos + 1;
+            while (end < code.size() && code[end] != c) {
+                if (code[end] == '\\') ++end;
+                else if (c == '`' && code[end] == '$' && end + 1 < code.size() && code[end + 1] == '{') result.opaque = true;
+                ++end;
+            }
+            pos = end + 1;
+            previousIdentifier.clear();
+            previousOperator.clear();
+            afterDot = afterDeclaration = false;
+            continue;
+        }
+
+        if (c.isDigit()) {
+            while (pos < code.size() && (isIdentifierPart(code[pos]) || code[pos] == '.')) ++pos;
+            previousIdentifier.clear();
+            previousOperator.clear();
+            afterDot = afterDeclaration = false;
+            continue;
+        }
+
+        if (isIdentifierStart(c)) {
+            int start = pos;
+            while (pos < code.size() && isIdentifierPart(code[pos])) ++pos;
+            QString name = code.mid(start, pos - start);
+            int next = pos;
+            skipSpace(code, next);
+            QString following = operatorAt(code, next);
+            bool called = following == "(";
+
+            if (afterDot) {
+                // Property of the object before the dot, only calls of builtins and impure members matter
+                auto members = pureMembers.constFind(previousIdentifier);
+                if (previousIdentifier == builtinObject) {
+                    builtins.insert(name);
+                } else if (isWrite(following) || (called && !pureGlobals.contains(previousIdentifier))) {
+                    result.opaque = true;   // Object changed through a property or a method
+                } else if (members != pureMembers.constEnd() && !members->contains(name)) {
+                    result.opaque = true;   // Not known to be pure, e.g. Math.random
+                }
+            } else if (opaqueNames.contains(name)) {
+                result.opaque = true;
+            } else if (name == "var" || name == "let" || name == "const") {
+                afterDeclaration = true;
+                previousIdentifier = name;
+                previousOperator.clear();
+                continue;
+            } else if (!jsKeywords.contains(name) && name != builtinObject && !pureGlobals.contains(name)) {
+                if (called) {
+                    result.opaque = true;   // Function defined by the script, may touch anything
+                }
+                reads.insert(name);
+                if (afterDeclaration || previousOperator == "++" || previousOperator == "--" || isWrite(following)) {
+                    writes.insert(name);
+                }
+            }
+
+            previousIdentifier = name;
+            previousOperator.clear();
+            afterDot = afterDeclaration = false;
+            continue;
+        }
+
+        QString op = operatorAt(code, pos);
+        if (op == "[" && (previousIdentifier == builtinObject || pureMembers.contains(previousIdentifier))) {
+            result.opaque = true;   // Builtin or member of a pure global accessed by a computed name
+        }
+        if (isWrite(op) && previousOperator == "]") {
+            result.opaque = true;   // Element of an array or object changed
+        }
+
+        pos += op.size();
+        afterDot = op == ".";
+        if (!afterDot) {
+            previousIdentifier.clear();
+        }
+        previousOperator = op;
+        afterDeclaration = false;
+    }
+
+    result.reads = reads.values();
+    result.writes = writes.values();
+    result.builtins = builtins.values();
+    return result;
+}
+
+/**
+ * @brief Gives the key a literal is compared by under loose equality.
+ *
+ * Literals of equal keys may be loosely equal to the same value. Number literals and strings
+ * in decimal notation are keyed by their number, so -0, 0 and "0.0" share a key. Other strings
+ * are keyed by themselves only if JS cannot read them as a number, e.g. "0x10" == 16 is true.
+ *
+ * @param literal The literal as written in the guard.
+ * @param key Receives the key.
+ * @return False if the literal cannot be keyed safely.
+ */
+static bool literalKey(const QString& literal, QString& key) {
+    static const QRegularExpression decimal(R"(^[-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?$)");
+    static const QRegularExpression legacyOctal(R"(^-?0\d)");
+    static const QRegularExpression digit(R"(\d)");
+
+    QString text = literal;
+    bool quoted = literal.startsWith('"') || literal.startsWith('\'');
+    if (quoted) {
+        text = literal.mid(1, literal.size() - 2);
+    } else if (legacyOctal.match(text).hasMatch()) {
+        return false;   // 010 is 8 in sloppy mode
+    }
+
+    if (decimal.match(text).hasMatch()) {
+        bool ok = false;
+        double number = text.toDouble(&ok);
+        if (!ok) {
+            return false;
+        }
+        key = "n" + (number == 0 ? QString("0") : QString::number(number, 'g', 17));
+        return true;
+    }
+
+    // Anything else JS might still read as a number: hex, binary, octal, blanks, Infinity
+    if (text.contains(digit) || text.trimmed().isEmpty() || text.contains("Infinity")) {
+        return false;
+    }
+    key = "s" + text;
+    return true;
+}
+
+/**
+ * @brief Splits an equality guard into the compared name and the literal.
+ * @param condition The JS condition.
+ * @param name Receives the compared name.
+ * @param literal Receives the key of the literal, see literalKey().
+ * @return False if the guard is not a single equality of a name and a safely keyed literal.
+ */
+static bool splitEquality(const QString& condition, QString& name, QString& literal) {
+    static const QString identifier = R"(([A-Za-z_$][\w$]*))";
+    static const QString value = R"((-?\d+(?:\.\d+)?|"[^"\\]*"|'[^'\\]*'))";
+    static const QRegularExpression nameFirst("^\\s*\\(?\\s*" + identifier + "\\s*===?\\s*" + value + "\\s*\\)?\\s*;?\\s*$");
+    static const QRegularExpression literalFirst("^\\s*\\(?\\s*" + value + "\\s*===?\\s*" + identifier + "\\s*\\)?\\s*;?\\s*$");
+
+    QString written;
+    QRegularExpressionMatch match = nameFirst.match(condition);
+    if (match.hasMatch()) {
+        name = match.captured(1);
+        written = match.captured(2);
+    } else if ((match = literalFirst.match(condition)).hasMatch()) {
+        name = match.captured(2);
+        written = match.captured(1);
+    } else {
+        return false;
+    }
+    if (jsKeywords.contains(name) || opaqueNames.contains(name)) {
+        return false;
+    }
+    return literalKey(written, literal);
+}
+
+bool areMutuallyExclusive(const QStringList& conditions) {
+    QString sharedName;
+    QSet<QString> literals;
+    for (const QString& condition : conditions) {
+        QString name;
+        QString literal;
+        if (!splitEquality(condition, name, literal)) {
+            return false;
+        }
+        if (!sharedName.isEmpty() && name != sharedName) {
+            return false;
+        }
+        sharedName = name;
+        if (literals.contains(literal)) {
+            return false;
+        }
+        literals.insert(literal);
+    }
+    return true;
+}
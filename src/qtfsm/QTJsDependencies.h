@@ -0,0 +1,52 @@
+/**
+ * @file QTJsDependencies.h
+ * @brief Header of the static analysis of the variables read and written by JS snippets.
+ * @author xnovakf00
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @struct JsDependencies
+ * @brief Global names a guard, delay or state action reads and writes.
+ *
+ * The analysis is a conservative scan of the tokens, not a full JS parser. Whatever it cannot
+ * account for (eval, this, with, calls of functions defined in JS, Date, Math.random, template
+ * literals with substitutions) marks the snippet as opaque. A default constructed value is
+ * opaque as well, so code that was never analyzed is treated as reading and writing anything.
+ */
+struct JsDependencies {
+    QStringList reads;      ///< Global names read, inputs and internals among them
+    QStringList writes;     ///< Global names assigned, incremented or declared
+    QStringList builtins;   ///< Functions of the fsm object called, e.g. "elapsed"
+    bool opaque = true;     ///< Reads or writes state the analysis does not track
+
+    /**
+     * @brief Checks whether the result depends only on the names in reads.
+     * @return True if the snippet may be skipped while none of the reads changed.
+     */
+    bool isPure() const;
+};
+
+/**
+ * @brief Extracts the dependencies of a JS snippet.
+ * @param code The JS code of a guard, delay or state action.
+ * @return The dependencies, opaque when the code uses anything the scan cannot follow.
+ */
+JsDependencies analyzeJsDependencies(const QString& code);
+
+/**
+ * @brief Checks whether at most one of the guards can be true at a time.
+ *
+ * Proven only for guards of the form "name == literal" (or ===, either side) that compare the
+ * same name with literals that differ even under loose equality. Strings JS could read as a
+ * number in another notation than plain decimal, such as "0x10" or " ", are never proven.
+ *
+ * @param conditions The JS conditions of the guards.
+ * @return True if the guards are provably mutually exclusive.
+ */
+bool areMutuallyExclusive(const QStringList& conditions);
@@ -15,7 +15,9 @@
 #include <QEvent>
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include "QTConditionEvent.h"
+#include "QTJsDependencies.h"
 #include "../common/EItemType.h"
 #include "../messages/Message.h"
 
@@ -68,6 +70,26 @@ private:
      */
     int id;
 
+    /**
+     * @brief Variables and builtins the condition reads.
+     */
+    JsDependencies guardDependencies;
+
+    /**
+     * @brief Whether cachedPass holds the result for cachedStamp.
+     */
+    bool cached = false;
+
+    /**
+     * @brief Last result of a pure condition.
+     */
+    bool cachedPass = false;
+
+    /**
+     * @brief Dependency stamp the cached result was computed at.
+     */
+    uint64_t cachedStamp = 0;
+
 public:
     /**
      * @brief Constructs a JsConditionTransition object.
@@ -78,6 +100,8 @@ public:
      * @param parentState Parent state of this transition.
      * @param delayExpr Delay expression in JavaScript to defer transition.
      * @param fsm Pointer to the FSM this transition belongs to.
+     * @param id Id of the transition in the gui.
+     * @param dependencies Variables the condition reads.
      */
     JsConditionTransition(QJSEngine* engine,
                           const QString& condition,
@@ -85,14 +109,16 @@ public:
                           QState* parentState,
                           const QString& delayExpr,
                           QTfsm* fsm,
-                          int id)
+                          int id,
+                          const JsDependencies& dependencies = JsDependencies())
         : QAbstractTransition(parentState),
           jsEngine(engine),
           jsCondition(condition),
           inputKey(expectedInputKey),
           delayExpression(delayExpr),
           automaton(fsm),
-          id(id){}
+          id(id),
+          guardDependencies(dependencies) {}
 
     /**
      * @brief Starts the delay timer based on the evaluated delay expression.
@@ -101,6 +127,7 @@ public:
     bool startDelayTimer() {
         ready = false;
         QJSValue result = jsEngine->evaluate(delayExpression);
+        automaton->collectChangedVariables();
         if (result.isError()) {
             qWarning() << "Invalid delay expression:" << delayExpression << "->" << result.toString();
             return false;
@@ -116,7 +143,7 @@ public:
         delayTimer->setSingleShot(true);
         QObject::connect(delayTimer, &QTimer::timeout, this, [this]() {
             ready = true;
-            auto* triggerEvent = new JsConditionEvent(automaton->map, this->inputKey);
+            auto* triggerEvent = new JsConditionEvent(this->inputKey, automaton->inputStore.pin());
             this->automaton->postEvent(triggerEvent);
         });
 
@@ -124,6 +151,22 @@ public:
         return false;
     }
 
+    /**
+     * @brief Gets the key of the input triggering the transition.
+     * @return The input key, empty for epsilon transitions.
+     */
+    const QString& getInputKey() const {
+        return inputKey;
+    }
+
+    /**
+     * @brief Gets the id of the transition.
+     * @return The id used by the gui.
+     */
+    int getId() const {
+        return id;
+    }
+
     /**
      * @brief Cancels and deletes the active delay timer if it was started
      */
@@ -136,6 +179,41 @@ public:
         ready = false;
     }
 
+private:
+    /**
+     * @brief Evaluates the condition, a pure one only when a variable it reads changed.
+     * @param pass Receives the result of the condition.
+     * @return False if the condition could not be evaluated.
+     */
+    bool evaluateCondition(bool& pass) {
+        bool pure = guardDependencies.isPure();
+        uint64_t stamp = pure ? automaton->dependencyStamp(guardDependencies.reads) : 0;
+        if (pure && cached && stamp == cachedStamp) {
+            pass = cachedPass;
+            return true;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QJSValue result = jsEngine->evaluate(jsCondition);
+        if (result.isError()) {
+            qDebug() << "Condition error:" << jsCondition << result.toString();
+            return false;
+        }
+
+        pass = result.isBool() && result.toBool();
+        automaton->recordGuard(id, pass, static_cast<uint64_t>(timer.nsecsElapsed()));
+        if (!pure) {
+            automaton->collectChangedVariables();   // The guard may have assigned internals
+        }
+        if (pure) {
+            cached = true;
+            cachedPass = pass;
+            cachedStamp = stamp;
+        }
+        return true;
+    }
+
 protected:
     /**
      * @brief Tests whether an event should trigger this transition.
@@ -165,19 +243,13 @@ protected:
             return true;
         }
 
-        // Inject event variables into JS context
-        QVariantMap vars = jsEvent->eventData;
-        for (auto it = vars.constBegin(); it != vars.constEnd(); ++it) {
-            jsEngine->globalObject().setProperty(it.key(), jsEngine->toScriptValue(it.value()));
-        }
+        // Bring the JS context to the inputs of the event, only changed inputs are set
+        automaton->syncInputs(jsEvent->version);
 
-        QJSValue result = jsEngine->evaluate(jsCondition);
-        if (result.isError()) {
-            qDebug() << "Condition error:" << jsCondition << result.toString();
+        bool pass = false;
+        if (!evaluateCondition(pass)) {
             return false;
         }
-
-        bool pass = result.isBool() && result.toBool();
         if (!pass) {
             qDebug() << "Condition evaluated to false:" << jsCondition;
             return false;
@@ -196,23 +268,6 @@ protected:
      * @param event The event that caused the transition.
      */
     void onTransition(QEvent*) override {
-        QDateTime now = QDateTime::currentDateTime();
-        QString timeStr = now.toString("yyyy-MM-dd hh:mm:ss");
-        std::string timeStamp = timeStr.toStdString();
-
-        EItemType elementType = EItemType::TRANSITION;
-        std::string currentElement = std::to_string(id);
-
-        Message log;
-        log.buildLogMessage(
-            timeStamp,
-            elementType,
-            currentElement,
-            automaton->getStringMap(automaton->getInputs()),
-            automaton->getStringMap(automaton->getOutputs()),
-            automaton->getStringMap(automaton->getVars())
-        );
-
-        automaton->getNetworkHandler().sendToHost(log.toMessageString());
+        automaton->publishLog(EItemType::TRANSITION, std::to_string(id));
     }
 };
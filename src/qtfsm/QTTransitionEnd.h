@@ -40,13 +40,13 @@ protected:
      * @brief Executes the transition action when triggered.
      * 
      * This method is invoked when the transition is triggered. It creates a stop message 
-     * and sends it to the host through the FSM's `NetworkHandler`.
+     * and sends it to the host through the FSM.
      * 
      * @param event The event that triggered the transition (not used in this case).
      */
     void onTransition(QEvent*) override {
         Message msg = Message(); // Create a Message object.
         msg.buildStopMessage(); // Build the stop message.
-        automaton->getNetworkHandler().sendToHost(msg.toMessageString()); // Send the message to the host.
+        automaton->sendMessage(msg); // Send the message to the host.
     }
 };
\ No newline at end of file
@@ -11,11 +11,12 @@
 #include <QDebug>
 #include "QTTransition.h"
 #include "QTBuiltinHandler.h"
-#include <QDateTime>
 #include <QApplication>
 #include "../common/EItemType.h"
 #include "../messages/Message.h"
 #include <QSignalTransition>
+#include <QJSValueIterator>
+#include <algorithm>
 QTfsm::QTfsm(QObject* parent, const std::string& name) 
     : QObject(parent), jsonName(name), networkHandler("127.0.0.1", 8080), connected(false) {
     this->automaton = new QState(&machine);
@@ -25,7 +26,8 @@ QTfsm::QTfsm(QObject* parent, const std::string& name)
     QObject::connect(transition, &QSignalTransition::triggered, this->getMachine(), [=]() {
     Message msg;
     msg.buildStopMessage();
-    this->getNetworkHandler().sendToHost(msg.toMessageString());
+    msg.setSessionId(this->sessionId);
+    this->sendMessage(msg);
     this->getNetworkHandler().closeConnection();
     });
 
@@ -37,7 +39,8 @@ QTfsm::QTfsm(QObject* parent, const std::string& name)
     QObject::connect(manualTransition, &QSignalTransition::triggered, this, [=]() {
         Message msg;
         msg.buildStopMessage();
-        this->getNetworkHandler().sendToHost(msg.toMessageString());
+        msg.setSessionId(this->sessionId);
+        this->sendMessage(msg);
         this->getNetworkHandler().closeConnection();
     });
 
@@ -87,40 +90,31 @@ QJSEngine* QTfsm::getJsEngine(){
 }
 
 void QTfsm::initializeJsEngine() {
-    QTBuiltinHandler* builtinHandler = new QTBuiltinHandler(nullptr, this);
+    QTBuiltinHandler* builtinHandler = new QTBuiltinHandler(this, this);
     this->builtinHandler = builtinHandler;
-    QJSValue builtinHandlerJs = engine.newQObject(builtinHandler);
-    engine.globalObject().setProperty("fsm", builtinHandlerJs);
+    engine.globalObject().setProperty("fsm", builtinHandler->install(engine));
 }
 
-void QTfsm::addStateJsAction(QState* state, const QString& jsCode) {
+void QTfsm::addStateJsAction(QState* state, const QString& jsCode, const JsDependencies& dependencies) {
     
-    QObject::connect(state, &QState::entered, this, [this, jsCode, state]() {
+    QObject::connect(state, &QState::entered, this, [this, jsCode, state, dependencies]() {
         builtinHandler->stateEntered(state);
         QJSValue result = this->engine.evaluate(jsCode);
         if (result.isError()) {
             qWarning() << "JavaScript error in state entry action:" << result.toString();
         }
-        // TimeStamp
-        QDateTime now = QDateTime::currentDateTime();
-        QString timeStr = now.toString("yyyy-MM-dd hh:mm:ss");  // or any format you want
-        std::string timeStamp = timeStr.toStdString();
-        // Elem State
-        EItemType elementType = EItemType::STATE;
-        // currentElem
-        const std::string currentElement = state->objectName().toStdString();
-        Message log = Message();
-        log.buildLogMessage(timeStamp,
-            elementType,
-            currentElement,
-            getStringMap(this->inputValues),
-            getStringMap(this->outputValues),
-            getStringMap(this->internalValues));
-
-        this->networkHandler.sendToHost(log.toMessageString());
+        // Guards reading what the action wrote have to be evaluated again
+        collectChangedVariables();
+        if (dependencies.opaque) {
+            markAllWritten();
+        } else {
+            for (const QString& name : dependencies.writes) {
+                markWritten(name);
+            }
+        }
+        this->publishLog(EItemType::STATE, state->objectName().toStdString());
         // epsilon
-        QString empty = "";
-        this->postEvent(new JsConditionEvent(map, empty));
+        this->postEvent(new JsConditionEvent(QString(), inputStore.pin()));
 
     }, Qt::QueuedConnection);
 
@@ -146,30 +140,231 @@ QAbstractState* QTfsm::getStateByName(const QString& name) const {
 }
 
 void QTfsm::setJsVariable(const QString& name, const QJSValue& value) {
-    this->internalValues[name.toStdString()] = value;
-    engine.globalObject().setProperty(name, value);
+    if (defineTracked.isUndefined()) {
+        // The setter records the name, so writes by actions and guards are found without a scan
+        changedVariables = engine.newObject();
+        defineTracked = engine.evaluate(
+            "(function (global, changed, name, value) {"
+            "    var current = value;"
+            "    Object.defineProperty(global, name, {"
+            "        get: function () { return current; },"
+            "        set: function (v) { current = v; changed[name] = true; },"
+            "        enumerable: true, configurable: true"
+            "    });"
+            "})");
+    }
+
+    std::string key = name.toStdString();
+    this->internalValues[key] = value;
+    this->internalTexts[key] = toText(value);
+    QJSValue result = defineTracked.call({engine.globalObject(), changedVariables, name, value});
+    if (result.isError()) {
+        qWarning() << "Cannot track internal variable" << name << ":" << result.toString();
+        engine.globalObject().setProperty(name, value);
+    }
+    markWritten(name);
+}
+
+void QTfsm::collectChangedVariables() {
+    if (builtinHandler) {
+        builtinHandler->collectOutputs([this](const QString& name, const QJSValue& value) {
+            setOutput(name, value);
+        });
+    }
+    if (changedVariables.isUndefined()) {
+        return;
+    }
+
+    QJSValueIterator it(changedVariables);
+    QStringList names;
+    while (it.hasNext()) {
+        it.next();
+        names.append(it.name());
+    }
+
+    QJSValue global = engine.globalObject();
+    for (const QString& name : names) {
+        QJSValue value = global.property(name);
+        std::string key = name.toStdString();
+        this->internalValues[key] = value;
+        this->internalTexts[key] = toText(value);
+        changedVariables.deleteProperty(name);
+        markWritten(name);
+    }
 }
 
 void QTfsm::setOutput(const QString& name, const QJSValue& value) {
-    this->outputValues[name.toStdString()] = value;
+    std::string key = name.toStdString();
+    this->outputValues[key] = value;
+    this->outputTexts[key] = toText(value);
 }
 void QTfsm::setInput(const QString& name, const QJSValue& value) {
-    this->inputValues[name.toStdString()] = value;
+    std::string key = name.toStdString();
+    this->inputValues[key] = value;
+    this->inputTexts[key] = toText(value);
+}
+
+QJSValue QTfsm::toScriptValue(const TypedValue& value) {
+    switch (value.type()) {
+        // JS numbers are doubles, integers beyond 2^53 lose precision like in any script
+        case EValueType::INT: return QJSValue(static_cast<double>(value.toInt()));
+        case EValueType::FLOAT: return QJSValue(value.toDouble());
+        case EValueType::BOOL: return QJSValue(value.toBool());
+        default: return QJSValue(QString::fromStdString(value.str()));
+    }
+}
+
+QVariant QTfsm::toVariant(const TypedValue& value) {
+    switch (value.type()) {
+        case EValueType::INT: return QVariant(static_cast<qlonglong>(value.toInt()));
+        case EValueType::FLOAT: return QVariant(value.toDouble());
+        case EValueType::BOOL: return QVariant(value.toBool());
+        default: return QVariant(QString::fromStdString(value.str()));
+    }
+}
+
+std::string QTfsm::toText(const QJSValue& value) {
+    return value.toString().toStdString();
 }
 
 
-void QTfsm::addJsTransition(QState* from, QAbstractState* to, const QString& condition, const QString& expectedInput, const QString& timeout, int id) {
-    JsConditionTransition *trans = new JsConditionTransition(&this->engine, condition, expectedInput, from, timeout, this, id);
+void QTfsm::addJsTransition(QState* from, QAbstractState* to, const QString& condition, const QString& expectedInput, const QString& timeout, int id, const JsDependencies& guardDependencies) {
+    JsConditionTransition *trans = new JsConditionTransition(&this->engine, condition, expectedInput, from, timeout, this, id, guardDependencies);
+    guardStats.registerGuard(id, condition);
 
     trans->setTargetState(to);
     from->addTransition(trans);
 }
 
+void QTfsm::publishLog(EItemType elementType, const std::string& currentElement) {
+    // Formatting is left to the consumers, stamping is a single clock read
+    EventTime now = sessionClock.now();
+    // Texts are kept up to date on every write, nothing is converted here
+    collectChangedVariables();
+    const std::map<std::string, std::string>& inputs = this->inputTexts;
+    const std::map<std::string, std::string>& outputs = this->outputTexts;
+    const std::map<std::string, std::string>& internals = this->internalTexts;
+
+    if (this->journal) {
+        this->journal->append(now.wallNs() / 1000000, elementType, currentElement, inputs, outputs, internals);
+    }
+
+    ++publishedLogs;
+    Message log;
+    log.setSessionId(this->sessionId);
+    log.buildLogMessage(now,
+        elementType,
+        currentElement,
+        inputs,
+        outputs,
+        internals);
+
+    // Serialize once, both consumers get the same bytes
+    std::string serialized = log.toMessageString();
+    if (this->messageSink) {
+        this->messageSink(log);
+    } else {
+        this->networkHandler.sendToHost(serialized);
+    }
+    if (this->logRing && !this->logRing->publish(serialized)) {
+        FSM_LOG_WARNING("LOG message too large for the shared memory ring, not published.");
+    }
+}
 
 void QTfsm::postEvent(QEvent* event) {
     getMachine()->postEvent(event);
 }
 
+void QTfsm::applyInput(const QString& name, const TypedValue& value) {
+    if (builtinHandler && !inputStore.contains(name)) {
+        builtinHandler->inputDefined(name);
+    }
+    QVariant typed = toVariant(value);
+    inputStore.set(name, typed);
+    setInput(name, toScriptValue(value));
+    postEvent(new JsConditionEvent(name, inputStore.pin(), typed));
+}
+
+void QTfsm::syncInputs(uint64_t version) {
+    inputStore.syncTo(version, [this](const QString& name, const QVariant& value) {
+        engine.globalObject().setProperty(name, engine.toScriptValue(value));
+        markWritten(name);
+    });
+}
+
+void QTfsm::addReorderableGroup(QState* state, const QString& inputKey) {
+    reorderableGroups.emplace_back(state, inputKey);
+}
+
+void QTfsm::setGuardStatsPath(const QString& path) {
+    guardStatsPath = path;
+}
+
+void QTfsm::recordGuard(int id, bool pass, uint64_t costNs) {
+    if (!guardStats.record(id, pass, costNs) || reorderableGroups.empty() || reorderPending) {
+        return;
+    }
+    // Not while the machine is selecting transitions of the state
+    reorderPending = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        reorderPending = false;
+        reorderGuards();
+    }, Qt::QueuedConnection);
+}
+
+void QTfsm::reorderGuards() {
+    for (const auto& [state, inputKey] : reorderableGroups) {
+        QList<QAbstractTransition*> transitions = state->transitions();
+
+        // Positions of the group inside the transitions of the state
+        QList<int> positions;
+        QList<JsConditionTransition*> group;
+        for (int i = 0; i < transitions.size(); ++i) {
+            auto* jsTransition = dynamic_cast<JsConditionTransition*>(transitions[i]);
+            if (jsTransition && jsTransition->getInputKey() == inputKey) {
+                positions.append(i);
+                group.append(jsTransition);
+            }
+        }
+
+        QList<JsConditionTransition*> ranked = group;
+        std::stable_sort(ranked.begin(), ranked.end(), [this](JsConditionTransition* a, JsConditionTransition* b) {
+            return guardStats.score(a->getId()) > guardStats.score(b->getId());
+        });
+        if (ranked == group) {
+            continue;
+        }
+
+        // The machine tries transitions in the order they were added, so add them again
+        for (int i = 0; i < positions.size(); ++i) {
+            transitions[positions[i]] = ranked[i];
+        }
+        for (QAbstractTransition* transition : transitions) {
+            state->removeTransition(transition);
+        }
+        for (QAbstractTransition* transition : transitions) {
+            state->addTransition(transition);
+        }
+    }
+}
+
+void QTfsm::markWritten(const QString& name) {
+    writeVersions[name] = ++writeClock;
+}
+
+void QTfsm::markAllWritten() {
+    everythingWritten = ++writeClock;
+}
+
+uint64_t QTfsm::dependencyStamp(const QStringList& names) const {
+    // Versions only grow, so the maximum changes exactly when one of the variables is written
+    uint64_t stamp = everythingWritten;
+    for (const QString& name : names) {
+        stamp = std::max(stamp, writeVersions.value(name, 0));
+    }
+    return stamp;
+}
+
 std::string QTfsm::getName() {
     return this->jsonName;
 }
@@ -178,9 +373,52 @@ void QTfsm::emitStopSignal() {
     emit stopSignal();
 }
 
+void QTfsm::setSessionId(const std::string& sessionId) {
+    this->sessionId = sessionId;
+}
+
+void QTfsm::setMessageSink(MessageSink sink) {
+    this->messageSink = std::move(sink);
+}
+
+void QTfsm::sendMessage(const Message& msg) {
+    if (this->messageSink) {
+        this->messageSink(msg);
+    } else {
+        this->networkHandler.sendToHost(msg.toMessageString());
+    }
+}
+
+std::string QTfsm::getSessionId() const {
+    return this->sessionId;
+}
+
+uint64_t QTfsm::getPublishedLogCount() const {
+    return this->publishedLogs;
+}
+
 void QTfsm::start() {
     initializeJsEngine();
-    this->connected = this->networkHandler.connectToServer();
+
+    // Local monitors may read LOG messages from shared memory instead of the socket
+    std::string ringName = ShmLogRing::nameFromEnvironment();
+    if (!ringName.empty()) {
+        this->logRing = std::make_unique<ShmLogRing>(sessionId.empty() ? ringName : ringName + "-" + sessionId);
+    }
+
+    // Persist the run for later queries and replay, every session in its own directory
+    std::string journalDir = JournalWriter::directoryFromEnvironment();
+    if (!journalDir.empty()) {
+        this->journal = std::make_unique<JournalWriter>(sessionId.empty() ? journalDir : journalDir + "/" + sessionId);
+    }
+
+    // Start with the order learned by earlier runs
+    if (!guardStatsPath.isEmpty() && guardStats.load(guardStatsPath)) {
+        reorderGuards();
+    }
+
+    // With a sink the messages never leave the process
+    this->connected = this->messageSink || this->networkHandler.connectToServer();
     if (!this->connected) {
         qWarning() << "Failed to connect to host. State machine will not start.";
         return;
@@ -190,6 +428,9 @@ void QTfsm::start() {
 }
 
 void QTfsm::stop() {
+    if (!guardStatsPath.isEmpty() && !guardStats.save(guardStatsPath)) {
+        FSM_LOG_WARNING("Cannot save guard statistics to " + guardStatsPath.toStdString());
+    }
     this->stopSignal();
     emit stopSignal();
     getMachine()->stop();
@@ -222,6 +463,7 @@ std::map<std::string, QJSValue> QTfsm::getInputs(){
 }
 
 std::map<std::string, QJSValue> QTfsm::getOutputs(){
+    collectChangedVariables();
     return this->outputValues;
 }
 std::map<std::string, QJSValue> QTfsm::getVars(){
@@ -14,7 +14,19 @@
 #include <QObject>
 #include <QJSEngine>
 #include "../networkHandler/NetworkHandler.h"
+#include "../networkHandler/ShmLogRing.h"
+#include "../messages/Message.h"
+#include "../journal/Journal.h"
+#include "../common/EItemType.h"
+#include "../common/TypedValue.h"
+#include "../common/SessionClock.h"
+#include <memory>
+#include <functional>
 #include "QTBuiltinHandler.h"
+#include "QTInputStore.h"
+#include "QTJsDependencies.h"
+#include "QTGuardStats.h"
+#include <QHash>
 
 class QTBuiltinHandler; // Forward declaration for QTBuiltinHandler
 
@@ -51,6 +63,53 @@ public:
      */
     void emitStopSignal();
 
+    /**
+     * @brief Sets the session the FSM runs in, must be called before start().
+     * 
+     * The id is carried by every message the FSM sends and separates the journal
+     * directory and the shared memory ring of the session from the others.
+     * 
+     * @param sessionId Id of the session, empty for the default session.
+     */
+    void setSessionId(const std::string& sessionId);
+
+    /**
+     * @brief Receiver of the LOG and STOP messages of the FSM, called on the FSM thread.
+     */
+    using MessageSink = std::function<void(const Message&)>;
+
+    /**
+     * @brief Hands the messages of the FSM to the receiver instead of a connection,
+     * must be called before start().
+     * 
+     * Without a sink the FSM connects to the listener at 127.0.0.1:8080 and sends
+     * its messages over that connection.
+     * 
+     * @param sink Receiver of the messages, empty to use the connection.
+     */
+    void setMessageSink(MessageSink sink);
+
+    /**
+     * @brief Sends a message of the FSM to the sink, or to the host without one.
+     * 
+     * @param msg The message to send.
+     */
+    void sendMessage(const Message& msg);
+
+    /**
+     * @brief Gets the session the FSM runs in.
+     * 
+     * @return Id of the session, empty for the default session.
+     */
+    std::string getSessionId() const;
+
+    /**
+     * @brief Gets the number of LOG messages published since the start.
+     * 
+     * @return Published LOG message count.
+     */
+    uint64_t getPublishedLogCount() const;
+
     // Setup methods for FSM
     /**
      * @brief Adds a state to the state machine.
@@ -80,8 +139,9 @@ public:
      * 
      * @param state The state to which the action will be added.
      * @param jsCode The JavaScript code to execute during the state's transition.
+     * @param dependencies Variables the code writes, marked as changed after every run.
      */
-    void addStateJsAction(QState* state, const QString& jsCode);
+    void addStateJsAction(QState* state, const QString& jsCode, const JsDependencies& dependencies = JsDependencies());
 
     /**
      * @brief Adds a JavaScript-based transition between two states.
@@ -92,13 +152,15 @@ public:
      * @param expectedInput The expected input for the transition.
      * @param timeout The timeout condition for the transition.
      * @param id Id of the transition for gui later.
+     * @param guardDependencies Variables the condition reads, a pure guard is re-evaluated only when they change.
      */
     void addJsTransition(QState* from, 
                          QAbstractState* to, 
                          const QString& jsCondition, 
                          const QString& expectedInput, 
                          const QString& timeout,
-                         int id);
+                         int id,
+                         const JsDependencies& guardDependencies = JsDependencies());
 
     /**
      * @brief Sets a JavaScript variable in the engine.
@@ -108,6 +170,25 @@ public:
      */
     void setJsVariable(const QString& name, const QJSValue& value);
 
+    /**
+     * @brief Converts a typed value to a JS value of the matching type.
+     * 
+     * Numbers and bools become JS numbers and booleans, so guards compare them natively
+     * instead of coercing strings on every evaluation.
+     * 
+     * @param value The typed value.
+     * @return The JS value.
+     */
+    QJSValue toScriptValue(const TypedValue& value);
+
+    /**
+     * @brief Converts a typed value to a variant of the matching type.
+     * 
+     * @param value The typed value.
+     * @return qlonglong, double, bool or QString variant.
+     */
+    static QVariant toVariant(const TypedValue& value);
+
     /**
      * @brief Sets an output value for the FSM.
      * 
@@ -195,6 +276,15 @@ public:
      */
     std::map<std::string, std::string> getStringMap(std::map<std::string, QJSValue> map);
 
+    /**
+     * @brief Builds a LOG message once and publishes it to the host, the shared memory ring
+     * and the journal.
+     * 
+     * @param elementType Type of the element that was entered or taken.
+     * @param currentElement Name of the state or id of the transition.
+     */
+    void publishLog(EItemType elementType, const std::string& currentElement);
+
     /**
      * @brief Posts an event to the event loop.
      * 
@@ -202,7 +292,77 @@ public:
      */
     void postEvent(QEvent* event);
 
-    QVariantMap map; /**< A map storing additional data related to the FSM for JSengine. */
+    /**
+     * @brief Stores a received input value and posts an event testing the transitions.
+     * 
+     * @param name The name of the input.
+     * @param value The new value in its native type.
+     */
+    void applyInput(const QString& name, const TypedValue& value);
+
+    /**
+     * @brief Sets the inputs changed since the last sync as JS globals, up to the version.
+     * 
+     * @param version Input version the conditions are evaluated at.
+     */
+    void syncInputs(uint64_t version);
+
+    /**
+     * @brief Records that a JS global was written.
+     * 
+     * @param name The name of the variable.
+     */
+    void markWritten(const QString& name);
+
+    /**
+     * @brief Records that any JS global may have been written.
+     */
+    void markAllWritten();
+
+    /**
+     * @brief Gets a stamp that changes whenever one of the variables is written.
+     * 
+     * @param names The variables.
+     * @return The latest write version among them.
+     */
+    uint64_t dependencyStamp(const QStringList& names) const;
+
+    /**
+     * @brief Reads back the internal variables and outputs JS code assigned since the last call.
+     * 
+     * Internals are accessor properties of the global object whose setters record the name,
+     * so the cost is proportional to the number of variables written, not declared. Outputs
+     * are collected from the builtin handler the same way.
+     */
+    void collectChangedVariables();
+
+    /**
+     * @brief Allows reordering the transitions of a state triggered by an input.
+     * 
+     * Only for guards proven mutually exclusive, the order then does not change which one fires.
+     * 
+     * @param state The source state.
+     * @param inputKey The input triggering the transitions.
+     */
+    void addReorderableGroup(QState* state, const QString& inputKey);
+
+    /**
+     * @brief Records an evaluation of a guard, revises the order of the guards periodically.
+     * 
+     * @param id Id of the transition.
+     * @param pass Result of the guard.
+     * @param costNs Evaluation time in nanoseconds.
+     */
+    void recordGuard(int id, bool pass, uint64_t costNs);
+
+    /**
+     * @brief Sets where the guard statistics are loaded from on start and saved to on stop.
+     * 
+     * @param path Path of the statistics file, empty to disable persistence.
+     */
+    void setGuardStatsPath(const QString& path);
+
+    QTInputStore inputStore; /**< Versioned input values, synced into the JSengine on demand. */
 
 signals:
     /**
@@ -221,5 +381,36 @@ private:
     std::map<std::string, QJSValue> outputValues; /**< Map of output values. */
     std::map<std::string, QJSValue> internalValues; /**< Map of internal variables. */
     std::map<std::string, QJSValue> inputValues; /**< Map of input values. */
-    QTBuiltinHandler* builtinHandler; /**< Built-in handler for specific FSM actions. */
+    QTBuiltinHandler* builtinHandler = nullptr; /**< Built-in handler for specific FSM actions. */
+    std::unique_ptr<ShmLogRing> logRing; /**< Shared memory ring for local monitors, null when disabled. */
+    std::unique_ptr<JournalWriter> journal; /**< On-disk record of the run, null when disabled. */
+    SessionClock sessionClock; /**< Stamps the LOG messages of the run. */
+    std::string sessionId; /**< Session the FSM runs in, empty for the default session. */
+    MessageSink messageSink; /**< Receiver of the messages, empty to send them over networkHandler. */
+    uint64_t publishedLogs = 0; /**< LOG messages published since the start. */
+    /**
+     * @brief Tries the guards of every reorderable group by decreasing score.
+     */
+    void reorderGuards();
+
+    /**
+     * @brief Converts a JS value to the text carried by LOG messages.
+     * 
+     * @param value The value.
+     * @return Its string form.
+     */
+    static std::string toText(const QJSValue& value);
+
+    QJSValue defineTracked; /**< JS function defining an internal as an accessor property. */
+    QJSValue changedVariables; /**< JS object whose keys are the internals written since the last readback. */
+    std::map<std::string, std::string> inputTexts; /**< Input values as carried by LOG messages. */
+    std::map<std::string, std::string> outputTexts; /**< Output values as carried by LOG messages. */
+    std::map<std::string, std::string> internalTexts; /**< Internal values as carried by LOG messages. */
+    QHash<QString, uint64_t> writeVersions; /**< Write version of every written JS global. */
+    uint64_t writeClock = 0; /**< Version of the last write. */
+    uint64_t everythingWritten = 0; /**< Version of the last write that may have touched any global. */
+    QTGuardStats guardStats; /**< Pass rates and costs of the guards. */
+    QString guardStatsPath; /**< File the statistics persist in, empty when not persisted. */
+    std::vector<std::pair<QState*, QString>> reorderableGroups; /**< States and inputs whose guards may be reordered. */
+    bool reorderPending = false; /**< Whether a reordering is queued. */
 };
@@ -8,6 +8,7 @@
 #include "QTfsm.h"
 #include "QTfsmBuilder.h"
 #include "../fsm/State.h"
+#include <map>
 #include <utility>
 #include "../fsm/Transition.h"
 #include "../messages/Message.h"
@@ -17,30 +18,33 @@ bool QTfsmBuilder::buildQTfsm(const QJsonDocument& jsonDoc) {
     this->innerFsm = loader.fromJson(jsonDoc);
 
     this->built = new QTfsm(nullptr, this->innerFsm->getName());
-    auto states = this->innerFsm->getStates();
-    for (auto state : states) {
-        QString stateName = QString::fromStdString(state.first);
-        QString stateAction = QString::fromStdString(state.second->getActionCode());
+    const StateTable& states = this->innerFsm->getStates();
+    for (const auto& state : states) {
+        QString stateName = QString::fromStdString(state->getName());
+        QString stateAction = QString::fromStdString(state->getActionCode());
         QState* toBeSet;
-        if (state.second->isFinalState()) {
+        if (state->isFinalState()) {
             this->built->addFinalState(stateName);
             continue;
-        } else if (state.second->isInitialState()) {
+        } else if (state->isInitialState()) {
             addedInitial = true;
             toBeSet = this->built->addState(stateName);
             this->built->setInitialState(toBeSet);
         } else {
             toBeSet = this->built->addState(stateName);
         }
-        this->built->addStateJsAction(toBeSet, stateAction);
+        this->built->addStateJsAction(toBeSet, stateAction, analyzeJsDependencies(stateAction));
     }
     
     if (!addedInitial) {
         return false;
     }
 
-    auto transitions = this->innerFsm->getTransitions();
-    for (auto transition : transitions) {
+    // Guards competing for the same input of a state, in creation order
+    std::map<std::pair<QState*, QString>, QStringList> competing;
+
+    const auto& transitions = this->innerFsm->getTransitions();
+    for (const auto& transition : transitions) {
         QString srcName = QString::fromStdString(transition->getSource());
         QString trgtName = QString::fromStdString(transition->getTarget());
         QString cond = QString::fromStdString(transition->getGuardCondition());
@@ -49,13 +53,23 @@ bool QTfsmBuilder::buildQTfsm(const QJsonDocument& jsonDoc) {
         QState* srcState = qobject_cast<QState*>(this->built->getStateByName(srcName));
         QAbstractState* trgtState = this->built->getStateByName(trgtName);
         int id = transition->getId();
-        this->built->addJsTransition(srcState, trgtState, cond, input, timeout, id);
+        this->built->addJsTransition(srcState, trgtState, cond, input, timeout, id, analyzeJsDependencies(cond));
+        competing[{srcState, input}].append(cond);
+    }
+
+    // Only provably exclusive guards may be tried in a different order
+    for (const auto& [group, conditions] : competing) {
+        if (conditions.size() > 1 && areMutuallyExclusive(conditions)) {
+            this->built->addReorderableGroup(group.first, group.second);
+        }
     }
 
     auto variables = this->innerFsm->getInternalVars();
     
     for (auto var : variables) {
-        QJSValue val = this->built->getJsEngine()->toScriptValue(QString::fromStdString(var.getInitialValue()));
+        // Declared types are kept, so numeric guards do not coerce strings on every evaluation
+        TypedValue initial = TypedValue::parse(var.getInitialValue(), valueTypeFromString(var.getType()));
+        QJSValue val = this->built->toScriptValue(initial);
         QString name = QString::fromStdString(var.getName());
         this->built->setJsVariable(name, val);
         